@@ -33,8 +33,20 @@
 // ------------------- Usage -------------------
 /*
   To use the library:
-   - you need once define 'LA_WINDOW_IMPLEMENTATION' 
+   - you need once define 'LA_WINDOW_IMPLEMENTATION'
      before including the header in one of your source files.
+
+  To strip the subsystems you don't use (smaller `law_Data`, code and
+  dispatch), define before every include of the header:
+   - 'LAW_NO_MOUSE'       - the `mouse` events and the mouse input,
+   - 'LAW_NO_PEN'         - the `pen` and `pen_batch` events and the pen input,
+   - 'LAW_NO_TOUCH'       - the `window.touch` event and the touch input,
+   - 'LAW_NO_TEXT'        - the `key.text` event and the text input,
+   - 'LAW_NO_FRAMEBUFFER' - the render threads (`law_startRenderThread`),
+   - 'LAW_NO_CURSOR'      - the custom cursors (`law_createCursor`).
+   The events of a stripped subsystem are ignored by `law_postEvent`,
+   `law_getPredictedPointer` is removed with both the mouse and the pen,
+   and gdi32 is not loaded on Windows with both the framebuffer and the cursors.
 */
 
 
@@ -43,6 +55,7 @@
 
 #include <assert.h> // For assert
 #include <stdlib.h> // For malloc, free
+#include <stddef.h> // For offsetof
 
 #pragma region Declaration
 
@@ -142,6 +155,92 @@ void law_minimize(law_Window window);
  * @param window The window. */
 void law_maximize(law_Window window);
 
+/**
+ * @brief Parameters of a window created by `law_createMany`.
+ */
+typedef struct /*law_CreateInfo*/ {
+  int width;            // The width of the window
+  int height;           // The height of the window
+  const wchar_t* title; // The title of the window (optional)
+  law_Window parent;    // The parent window (optional)
+  int show;             // Non-zero to show the window with the others
+} law_CreateInfo;
+
+/**
+ * @brief Create several windows at once.
+ * 
+ * Creates every window like `law_create`, then shows the ones with
+ * `show` set together, in one native operation, instead of one
+ * show (and repaint of the screen) per window.
+ * 
+ * @param infos The parameters of the windows,
+ * @param count The number of windows,
+ * @param windows The created windows (NULL for the ones that failed).
+ * @return The number of windows created. */
+size_t law_createMany(const law_CreateInfo* infos, size_t count, law_Window* windows);
+
+/**
+ * @brief Create several windows, announced by the next `law_update`.
+ * 
+ * Works like `law_createMany`, but the windows are shown (together) by
+ * the next `law_update` of the thread, which reports every window with
+ * the `window.created` event, so the handlers can be set in between.
+ * 
+ * @param infos The parameters of the windows,
+ * @param count The number of windows,
+ * @param windows The created windows (NULL for the ones that failed).
+ * @return The number of windows created. */
+size_t law_createManyAsync(const law_CreateInfo* infos, size_t count, law_Window* windows);
+
+/**
+ * @brief Start recording the property changes of the window.
+ * 
+ * Until `law_commitUpdate`, `law_setPos`, `law_setSize` and `law_setTitle`
+ * only record the new values (the getters still return the current ones),
+ * the commit applies them all in one native operation, with a single
+ * `move` and `resize` event instead of one per call.
+ * The calls can be nested, the outermost commit applies the changes.
+ * 
+ * @param window The window. */
+void law_beginUpdate(law_Window window);
+
+/**
+ * @brief Apply the property changes recorded since `law_beginUpdate`.
+ * @param window The window. */
+void law_commitUpdate(law_Window window);
+
+/**
+ * @brief Get a hidden window of the pool, or create one.
+ * 
+ * Reuses a window given back by `law_releasePooledWindow` with the same
+ * `kind`, resized to `width` x `height`, instead of creating a native
+ * window: opening a tooltip or popup costs a resize and a show.
+ * The window is hidden, with the data of a new window (no handlers,
+ * `user_data` NULL, no title, at the position it was created at).
+ * 
+ * @param kind The kind of window (tooltip, popup, ..., chosen by the application),
+ * @param width The width of the window,
+ * @param height The height of the window.
+ * @return The window, or NULL if it could not be created.
+ * 
+ * @note Windows are pooled per thread (display), see `law_openDisplay`. */
+law_Window law_acquirePooledWindow(int kind, int width, int height);
+
+/**
+ * @brief Give the window back to the pool.
+ * 
+ * The window is hidden and its data reset, its queued events dropped
+ * and its render thread stopped, without the `destroy` event. Once the
+ * pool holds `LAW_WINDOW_POOL_SIZE` windows, the window is destroyed.
+ * The pooled windows don't count as open windows (see `law_runLoop`).
+ * 
+ * @param window The window (from `law_acquirePooledWindow` or `law_create`). */
+void law_releasePooledWindow(law_Window window);
+
+/**
+ * @brief Destroy the windows of the pool of the thread. */
+void law_clearWindowPool(void);
+
 // ------------------- Monitors -------------------
 #pragma region _monitors
 
@@ -154,6 +253,121 @@ law_Monitor law_getPrimaryMonitor();
 
 #pragma endregion _monitors
 
+// ------------------- Displays -------------------
+#pragma region _displays
+
+typedef void* law_Display;
+
+/**
+ * @brief Open a display connection for the calling thread.
+ * 
+ * The windows created by the thread are then created on this display,
+ * and `law_update` of the thread pumps only them. Every connection has
+ * its own event lists, time budget and dispatch pool, so threads serving
+ * different displays share no locks; threads without an opened display
+ * use the default one.
+ * 
+ * On Windows, `name` is the device name of a monitor (like `"\\\\.\\DISPLAY2"`)
+ * the windows are placed on, NULL for the primary monitor.
+ * With the headless backend it's only a label.
+ * 
+ * @param name The name of the display (optional).
+ * @return The display, NULL on failure.
+ * 
+ * @note A window belongs to the thread that created it, only that thread
+ * may use it. `law_postEventFromThread` hands the events over to the
+ * display of the window, the input thread (`law_startInputThread`) serves
+ * the windows of the thread that started it. */
+law_Display law_openDisplay(const char* name);
+
+/**
+ * @brief Close the display of the calling thread, the thread uses the default display again.
+ * @param display The display (its windows must be destroyed, and no thread
+ *        may still post to them with `law_postEventFromThread`). */
+void law_closeDisplay(law_Display display);
+
+#pragma endregion _displays
+
+// ------------------- Rendering -------------------
+#pragma region _render
+#ifndef LAW_NO_FRAMEBUFFER
+
+/**
+ * @brief A frame of the software swap chain of a window.
+ */
+typedef struct /*law_Frame*/ {
+  unsigned int* pixels; // The pixels, row after row from the top (0x00RRGGBB)
+  int width;            // The width of the frame (pixels), the client area when the frame was started
+  int height;           // The height of the frame (pixels)
+  int stride;           // The number of pixels from one row to the next
+} law_Frame;
+
+typedef void (*law_RenderFunc)(law_Window, law_Frame*, void*); // void func(law_Window window, law_Frame* frame, void* user)
+
+/**
+ * @brief Render the window on a thread of its own.
+ * 
+ * The thread calls `render` for every frame with the back buffer of a
+ * swap chain of three frames, sized to the client area of the window.
+ * `law_update` of the window's thread presents the latest finished frame
+ * and hands the current size of the window over to the next one; the
+ * thread renders at most one frame ahead of the presentation, and waits
+ * while the window has no area (minimized).
+ * The thread is stopped by `law_stopRenderThread` or `law_destroy`
+ * (before the destroy event), after the frame it's rendering.
+ * 
+ * @param window The window,
+ * @param render The function rendering a frame,
+ * @param user The user data passed to `render`.
+ * @return Non-zero if the thread was started.
+ * 
+ * @attention `render` runs on the render thread: it must only write the
+ * frame and its own data, no library function may be called. */
+int law_startRenderThread(law_Window window, law_RenderFunc render, void* user);
+
+/**
+ * @brief Stop the render thread of the window, waits for the frame being rendered.
+ * @param window The window. */
+void law_stopRenderThread(law_Window window);
+
+#endif // LAW_NO_FRAMEBUFFER
+#pragma endregion _render
+
+// ------------------- Cursors -------------------
+#pragma region _cursors
+#ifndef LAW_NO_CURSOR
+
+typedef void* law_Cursor;
+
+/**
+ * @brief Create a cursor from an image.
+ * 
+ * The image is handed to the system once, `law_setCursor` only switches
+ * between the created cursors: changing the cursor over the regions of
+ * a window never uploads the image again or redraws the window.
+ * 
+ * @param pixels The pixels, row after row from the top (0xAARRGGBB, not premultiplied),
+ * @param width The width of the image,
+ * @param height The height of the image,
+ * @param hot_x The x position of the hot spot in the image,
+ * @param hot_y The y position of the hot spot in the image.
+ * @return The cursor, or NULL if it could not be created. */
+law_Cursor law_createCursor(const unsigned int* pixels, int width, int height, int hot_x, int hot_y);
+
+/**
+ * @brief Destroy the cursor (it must not be set on any window).
+ * @param cursor The cursor. */
+void law_destroyCursor(law_Cursor cursor);
+
+/**
+ * @brief Set the cursor shown over the client area of the window.
+ * @param window The window,
+ * @param cursor The cursor, or NULL for the default one. */
+void law_setCursor(law_Window window, law_Cursor cursor);
+
+#endif // LAW_NO_CURSOR
+#pragma endregion _cursors
+
 
 // ------------------- Events -------------------
 #pragma region _events
@@ -166,6 +380,23 @@ typedef void (*__law_FuncWinDataIntInt)(law_Window, law_Data*, int, int); // voi
 typedef void (*__law_FuncWinDataUintIntIntInt)(law_Window, law_Data*, unsigned int, int, int, int); // void func(law_Window window, law_Data data, int, int, int)
 typedef void (*__law_FuncWinDataStr)(law_Window, law_Data*, const char*); // void func(law_Window window, law_Data data, const char*)
 
+/**
+ * @brief A single pen sample.
+ *
+ * Delivered in batches by the `pen_batch` event.
+ */
+typedef struct /*law_PenSample*/ {
+  unsigned int id;         // The ID of the pen
+  int x;                   // The x position of the pen in the client area (pixels)
+  int y;                   // The y position of the pen in the client area (pixels)
+  int pressure;            // The pressure of the pen (0-1024)
+  int tilt_x;              // The tilt of the pen on the x-axis
+  int tilt_y;              // The tilt of the pen on the y-axis
+  unsigned long long time; // The time the sample was taken (microseconds, monotonic)
+} law_PenSample;
+
+typedef void (*__law_FuncWinDataPenSamples)(law_Window, law_Data*, const law_PenSample*, size_t); // void func(law_Window window, law_Data data, const law_PenSample*, size_t)
+
 
 #pragma region _exit_func
 void (*__law_exit_func)(int) = NULL;
@@ -207,19 +438,25 @@ typedef struct /*law_WindowEvents*/ {
   __law_FuncWinDataIntInt move;   // The window has been moved to a different position on the screen
   __law_FuncWinData focus;        // The window has gained input focus
   __law_FuncWinData unfocus;      // The window has lost input focus
-  __law_FuncWinData redraw;       // The window needs to be redrawn (e.g., after a resize or exposure)
+  __law_FuncWinData redraw;       // The window needs to be redrawn (e.g., after a resize or exposure), called from `law_update`
   __law_FuncWinData minimize;     // The window has been minimized (iconified)
   __law_FuncWinData maximize;     // The window has been maximized (expanded)
   __law_FuncWinData show;         // The window is now visible on the screen
   __law_FuncWinData hide;         // The window is now hidden from the screen
+  __law_FuncWinData created;      // The window of `law_createManyAsync` is ready, called from the next `law_update`
   __law_FuncWinDataStr file_drop; // (currently not implemented on any platform) A file has been dropped into the window from an external source
+#ifndef LAW_NO_TOUCH
   __law_FuncWinDataIntInt touch;  // (currently not implemented on any platform) A touch event occurred within the window
+#endif
 } law_WindowEvents;
 
 // Keyboard events
 typedef struct /*law_KeyboardEvents*/ {
-  __law_FuncWinDataInt down; // A key has been pressed while the window is focused
-  __law_FuncWinDataInt up;   // A key has been released while the window is focused
+  __law_FuncWinDataInt down; // A key (`LAW_KEY_*`) has been pressed while the window is focused
+  __law_FuncWinDataInt up;   // A key (`LAW_KEY_*`) has been released while the window is focused
+#ifndef LAW_NO_TEXT
+  __law_FuncWinDataStr text; // Text has been typed (UTF-8), all characters of one `law_update` are delivered at once
+#endif
 } law_KeyboardEvents;
 
 // Mouse events
@@ -236,6 +473,140 @@ typedef struct /*law_MouseEvents*/ {
 #define LAW_MOUSE_X1 4     // Mouse X1 button (additional mouse button)
 #define LAW_MOUSE_X2 5     // Mouse X2 button (additional mouse button)
 
+// Keyboard keys (`key.down`, `key.up`)
+// Printable keys have the value of their (uppercase) ASCII character
+#define LAW_KEY_UNKNOWN 0
+#define LAW_KEY_SPACE 32
+#define LAW_KEY_APOSTROPHE 39    // '
+#define LAW_KEY_COMMA 44         // ,
+#define LAW_KEY_MINUS 45         // -
+#define LAW_KEY_PERIOD 46        // .
+#define LAW_KEY_SLASH 47         // /
+#define LAW_KEY_0 48
+#define LAW_KEY_1 49
+#define LAW_KEY_2 50
+#define LAW_KEY_3 51
+#define LAW_KEY_4 52
+#define LAW_KEY_5 53
+#define LAW_KEY_6 54
+#define LAW_KEY_7 55
+#define LAW_KEY_8 56
+#define LAW_KEY_9 57
+#define LAW_KEY_SEMICOLON 59     // ;
+#define LAW_KEY_EQUAL 61         // =
+#define LAW_KEY_A 65
+#define LAW_KEY_B 66
+#define LAW_KEY_C 67
+#define LAW_KEY_D 68
+#define LAW_KEY_E 69
+#define LAW_KEY_F 70
+#define LAW_KEY_G 71
+#define LAW_KEY_H 72
+#define LAW_KEY_I 73
+#define LAW_KEY_J 74
+#define LAW_KEY_K 75
+#define LAW_KEY_L 76
+#define LAW_KEY_M 77
+#define LAW_KEY_N 78
+#define LAW_KEY_O 79
+#define LAW_KEY_P 80
+#define LAW_KEY_Q 81
+#define LAW_KEY_R 82
+#define LAW_KEY_S 83
+#define LAW_KEY_T 84
+#define LAW_KEY_U 85
+#define LAW_KEY_V 86
+#define LAW_KEY_W 87
+#define LAW_KEY_X 88
+#define LAW_KEY_Y 89
+#define LAW_KEY_Z 90
+#define LAW_KEY_LEFT_BRACKET 91  // [
+#define LAW_KEY_BACKSLASH 92     // \ (backslash)
+#define LAW_KEY_RIGHT_BRACKET 93 // ]
+#define LAW_KEY_GRAVE 96         // `
+// Function keys
+#define LAW_KEY_ESCAPE 256
+#define LAW_KEY_ENTER 257
+#define LAW_KEY_TAB 258
+#define LAW_KEY_BACKSPACE 259
+#define LAW_KEY_INSERT 260
+#define LAW_KEY_DELETE 261
+#define LAW_KEY_RIGHT 262
+#define LAW_KEY_LEFT 263
+#define LAW_KEY_DOWN 264
+#define LAW_KEY_UP 265
+#define LAW_KEY_PAGE_UP 266
+#define LAW_KEY_PAGE_DOWN 267
+#define LAW_KEY_HOME 268
+#define LAW_KEY_END 269
+#define LAW_KEY_CAPS_LOCK 280
+#define LAW_KEY_SCROLL_LOCK 281
+#define LAW_KEY_NUM_LOCK 282
+#define LAW_KEY_PRINT_SCREEN 283
+#define LAW_KEY_PAUSE 284
+#define LAW_KEY_F1 290
+#define LAW_KEY_F2 291
+#define LAW_KEY_F3 292
+#define LAW_KEY_F4 293
+#define LAW_KEY_F5 294
+#define LAW_KEY_F6 295
+#define LAW_KEY_F7 296
+#define LAW_KEY_F8 297
+#define LAW_KEY_F9 298
+#define LAW_KEY_F10 299
+#define LAW_KEY_F11 300
+#define LAW_KEY_F12 301
+// Keypad
+#define LAW_KEY_KP_0 320
+#define LAW_KEY_KP_1 321
+#define LAW_KEY_KP_2 322
+#define LAW_KEY_KP_3 323
+#define LAW_KEY_KP_4 324
+#define LAW_KEY_KP_5 325
+#define LAW_KEY_KP_6 326
+#define LAW_KEY_KP_7 327
+#define LAW_KEY_KP_8 328
+#define LAW_KEY_KP_9 329
+#define LAW_KEY_KP_DECIMAL 330
+#define LAW_KEY_KP_DIVIDE 331
+#define LAW_KEY_KP_MULTIPLY 332
+#define LAW_KEY_KP_SUBTRACT 333
+#define LAW_KEY_KP_ADD 334
+#define LAW_KEY_KP_ENTER 335
+#define LAW_KEY_KP_EQUAL 336
+// Modifiers
+#define LAW_KEY_LEFT_SHIFT 340
+#define LAW_KEY_LEFT_CONTROL 341
+#define LAW_KEY_LEFT_ALT 342
+#define LAW_KEY_LEFT_SUPER 343   // Windows / Command key
+#define LAW_KEY_RIGHT_SHIFT 344
+#define LAW_KEY_RIGHT_CONTROL 345
+#define LAW_KEY_RIGHT_ALT 346
+#define LAW_KEY_RIGHT_SUPER 347
+#define LAW_KEY_MENU 348
+#define LAW_KEY_LAST LAW_KEY_MENU
+
+/**
+ * @brief Translate a Windows virtual-key code to `LAW_KEY_*`.
+ * @param vk The virtual-key code (`VK_*`),
+ * @param extended Non-zero for the extended variant of the key (bit 24 of
+ *        the `WM_KEYDOWN` lParam); the right shift key has no extended flag
+ *        and is passed as extended by its scan code (0x36).
+ * @return The key (`LAW_KEY_*`), or `LAW_KEY_UNKNOWN`. */
+int law_keyFromVk(unsigned int vk, int extended);
+
+/**
+ * @brief Translate an X11 keysym to `LAW_KEY_*`.
+ * @param keysym The keysym (`XK_*`, the unshifted keysym of the key).
+ * @return The key (`LAW_KEY_*`), or `LAW_KEY_UNKNOWN`. */
+int law_keyFromKeysym(unsigned long keysym);
+
+/**
+ * @brief Translate a Linux evdev key code to `LAW_KEY_*`.
+ * @param code The evdev key code (`KEY_*`, X11 keycodes are evdev codes + 8).
+ * @return The key (`LAW_KEY_*`), or `LAW_KEY_UNKNOWN`. */
+int law_keyFromEvdev(unsigned int code);
+
 /**
  * @brief The events structure for the window.
  * 
@@ -256,13 +627,16 @@ typedef struct /*law_Events*/ {
    * @note Use `LAW_KEY_*` for keys (e.g., `LAW_KEY_A`, `LAW_KEY_B`, etc.). */
   law_KeyboardEvents key;
   
+#ifndef LAW_NO_MOUSE
   /**
    * @brief The mouse events.
    * 
    * Contains functions to handle mouse events related to the window.
    * @note Use `LAW_MOUSE_*` for mouse buttons (e.g., `LAW_MOUSE_LEFT`, `LAW_MOUSE_RIGHT`, etc.). */
   law_MouseEvents mouse;
+#endif
 
+#ifndef LAW_NO_PEN
   /**
   * @brief (currently implemented on Windows only) The pen down event.
   * 
@@ -277,6 +651,24 @@ typedef struct /*law_Events*/ {
   * @note Windows API added support for pen events in Windows 8.
   */
   __law_FuncWinDataUintIntIntInt pen;
+
+  /**
+  * @brief (currently implemented on Windows only) The batched pen event.
+  * 
+  * Delivers every pen sample received since the last `law_update`,
+  * oldest first, with a single call per window and update.
+  * Unlike `pen`, the samples coalesced by the system between two
+  * native messages are not lost, so high-rate tablets (200-300 Hz)
+  * deliver all of their samples.
+  * 
+  * @param window The window where the pen samples occurred.
+  * @param samples The pen samples (const law_PenSample*)
+  * @param count The number of samples (size_t)
+  * 
+  * @note The `samples` array is only valid during the call.
+  */
+  __law_FuncWinDataPenSamples pen_batch;
+#endif
 } law_Events;
 
 /**
@@ -341,11 +733,236 @@ struct law_Data {
  */
 law_Data* law_getData(law_Window window);
 
+// Event types (`law_Event.type`)
+enum law_EventType
+{
+  LAW_EVENT_NONE = 0,
+  LAW_EVENT_DESTROY,     // window.destroy (dispatched immediately by `law_destroy`)
+  LAW_EVENT_CLOSE,       // window.close
+  LAW_EVENT_RESIZE,      // window.resize (`size`)
+  LAW_EVENT_MOVE,        // window.move (`pos`)
+  LAW_EVENT_FOCUS,       // window.focus
+  LAW_EVENT_UNFOCUS,     // window.unfocus
+  LAW_EVENT_REDRAW,      // window.redraw (merged, dispatched after all other events of the update)
+  LAW_EVENT_MINIMIZE,    // window.minimize
+  LAW_EVENT_MAXIMIZE,    // window.maximize
+  LAW_EVENT_SHOW,        // window.show
+  LAW_EVENT_HIDE,        // window.hide
+  LAW_EVENT_CREATED,     // window.created (`law_createManyAsync`)
+  LAW_EVENT_TOUCH,       // window.touch (`pos`)
+  LAW_EVENT_KEY_DOWN,    // key.down (`key`)
+  LAW_EVENT_KEY_UP,      // key.up (`key`)
+  LAW_EVENT_TEXT,        // key.text (`codepoint`, delivered with the rest of the text of the update)
+  LAW_EVENT_MOUSE_MOVE,  // mouse.move (`pos`)
+  LAW_EVENT_MOUSE_DOWN,  // mouse.down (`button`)
+  LAW_EVENT_MOUSE_UP,    // mouse.up (`button`)
+  LAW_EVENT_MOUSE_WHEEL, // mouse.wheel (`wheel`)
+  LAW_EVENT_PEN,         // pen and pen_batch (`pen`)
+  LAW_EVENT_COUNT
+};
+
+/**
+ * @brief A window event.
+ * 
+ * Compact record of a single event. Every backend translates its native
+ * events to this record, and one shared core filters, coalesces and
+ * dispatches them to the `law_Events` callbacks during `law_update`.
+ */
+typedef struct /*law_Event*/ {
+  int type;                // The type of the event (`LAW_EVENT_*`)
+  unsigned long long time; // The time the event was received (microseconds, monotonic), 0 for now
+  union {
+    struct { int width, height; } size; // LAW_EVENT_RESIZE
+    struct { int x, y; } pos;           // LAW_EVENT_MOVE, LAW_EVENT_TOUCH, LAW_EVENT_MOUSE_MOVE
+    int key;                            // LAW_EVENT_KEY_DOWN, LAW_EVENT_KEY_UP (`LAW_KEY_*`)
+    unsigned int codepoint;             // LAW_EVENT_TEXT (Unicode)
+    int button;                         // LAW_EVENT_MOUSE_DOWN, LAW_EVENT_MOUSE_UP (`LAW_MOUSE_*`)
+    int wheel;                          // LAW_EVENT_MOUSE_WHEEL
+    struct { unsigned int id; int x, y, pressure, tilt_x, tilt_y; } pen; // LAW_EVENT_PEN
+  };
+} law_Event;
+
+/**
+ * @brief Post an event to the window.
+ * 
+ * The event goes through the same filtering and coalescing as the
+ * native events and is dispatched by the next `law_update`.
+ * With the headless backend (`LAW_HEADLESS`) this is the only source of input.
+ * 
+ * @param window The window,
+ * @param event The event (`LAW_EVENT_DESTROY` can not be posted).
+ * @return Non-zero if the event was queued, 0 if the window has no handler for it. */
+int law_postEvent(law_Window window, const law_Event* event);
+
+typedef void (*__law_FuncWinDataEvent)(law_Window, law_Data*, const law_Event*); // void func(law_Window window, law_Data data, const law_Event*)
+
+// Bit of the event type in the mask of `law_setEventHandler`
+#define LAW_EVENT_MASK(type) (1u << (type))
+#define LAW_EVENT_MASK_ALL ((1u << LAW_EVENT_COUNT) - 1)
+
+/**
+ * @brief Set a single handler for several event types.
+ * 
+ * Events whose type is in `mask` are delivered to `handler` instead of
+ * the `law_Events` callbacks, types not in `mask` keep using the callbacks
+ * (and are filtered out if they have none). `LAW_EVENT_TEXT` is delivered
+ * per character (`codepoint`), `LAW_EVENT_PEN` per native message
+ * (`pen_batch` still receives every sample if set).
+ * It's used by `la_window.hpp` to bind the handlers at compile time.
+ * 
+ * @param window The window,
+ * @param handler The handler or NULL to remove it,
+ * @param mask The event types (`LAW_EVENT_MASK(LAW_EVENT_*)` combined with `|`). */
+void law_setEventHandler(law_Window window, __law_FuncWinDataEvent handler, unsigned int mask);
+
+typedef void (*__law_FuncWinDataEvents)(law_Window, law_Data*, const law_Event*, size_t); // void func(law_Window window, law_Data data, const law_Event*, size_t)
+
+/**
+ * @brief Set a handler receiving all events of an update at once.
+ * 
+ * The events of the window queued until `law_update` are delivered as
+ * contiguous arrays instead of one call per event, with one call per
+ * priority lane: first the input events (keys, text, mouse, pen, touch),
+ * then the window events (close, resize, move, focus, ...). Each array is
+ * oldest first, but the order is not kept across the lanes, so a key
+ * posted after a `LAW_EVENT_CLOSE` still comes in the first call.
+ * The redraw is merged for the update and delivered last as a batch of
+ * one event, after the events of every window.
+ * Every event type is subscribed and goes to the batch handler only,
+ * `LAW_EVENT_TEXT` is delivered per character (`codepoint`) and
+ * `LAW_EVENT_DESTROY` as a batch of one event when the window is destroyed.
+ * Events posted by the batch handler are delivered by a following call
+ * in the same update, the input lane first again.
+ * 
+ * @param window The window,
+ * @param handler The batch handler or NULL to go back to the per-event handlers.
+ * 
+ * @note The array is only valid during the call.
+ */
+void law_setBatchHandler(law_Window window, __law_FuncWinDataEvents handler);
+
+/**
+ * @brief Post an event from another thread.
+ * 
+ * The event is timestamped (unless `time` is set) and pushed into the
+ * lock-free ring of the display of the window (see `law_openDisplay`),
+ * the next `law_update` of that display posts it like `law_postEvent`.
+ * Used by the input thread (`law_startInputThread`), or by an application
+ * reading its own input devices.
+ * 
+ * @param window The window,
+ * @param event The event.
+ * @return Non-zero if the event was pushed, 0 if the ring is full
+ *         (`LAW_INPUT_RING_SIZE` events) or the window doesn't exist.
+ * 
+ * @attention Single producer per display: only one thread at a time may
+ * call it for the windows of a display, and none for the display of the
+ * input thread while it runs.
+ */
+int law_postEventFromThread(law_Window window, const law_Event* event);
+
+/**
+ * @brief Dispatch the events of different windows in parallel.
+ * 
+ * `law_update(NULL)` hands the windows with pending events to a
+ * work-stealing pool of threads: every window is dispatched by a single
+ * thread at a time, so the events of a window keep their order, while
+ * independent windows are handled at the same time. The redraws run in
+ * parallel too, after all other events.
+ * 
+ * @param threads The number of threads dispatching (the calling thread
+ *        is one of them), 0 or 1 to dispatch on the calling thread only.
+ * @return The number of threads dispatching.
+ * 
+ * @attention The handlers run on the worker threads: they must only use
+ * the data of their own window and may only call `law_postEvent` for it,
+ * no other library function (on Windows, the window functions would wait
+ * for the main thread).
+ */
+int law_setDispatchThreads(int threads);
+
+/**
+ * @brief (currently implemented on Windows only) Read the input on a background thread.
+ * 
+ * The keyboard and mouse are read on a dedicated thread (raw input on
+ * Windows), which timestamps and decodes the events at arrival, even
+ * while the main thread is busy rendering, and hands them over to
+ * `law_update` through the ring of `law_postEventFromThread`.
+ * The text input (`key.text`), touch and pen are still read by `law_update`.
+ * 
+ * @return Non-zero if the input thread is running. */
+int law_startInputThread(void);
+
+/**
+ * @brief Stop the input thread, the input is read by `law_update` again. */
+void law_stopInputThread(void);
+
 /**
  * @brief Process window events.
+ * 
+ * Reads the native events, then calls the handlers of the events
+ * queued for the window(s): the input events first, then the window
+ * events, followed by the batched events (`pen_batch`, `key.text`).
+ * The redraws run last, once per window and update.
+ * 
  * @param window The window or NULL to process all windows. */
 void law_update(law_Window window);
 
+/**
+ * @brief Process window events within a time budget.
+ * 
+ * Works like `law_update`, but stops reading and dispatching events once
+ * `budget_ns` nanoseconds have passed, so an event storm can not take
+ * the whole frame. The remaining events stay queued (consecutive mouse
+ * moves, resizes and moves of the backlog are merged) and are delivered
+ * by the next update, input first.
+ * 
+ * @param window The window or NULL to process all windows,
+ * @param budget_ns The time budget (nanoseconds).
+ * @return Non-zero if the budget ran out, the remaining events are left for the next update.
+ * 
+ * @note A handler that is running is never interrupted, the budget is
+ * checked between the events (the clock resolution is 1 microsecond).
+ */
+int law_updateFor(law_Window window, unsigned long long budget_ns);
+
+/**
+ * @brief Run a fixed-timestep loop until `law_exit`.
+ * 
+ * Every iteration calls `law_update(NULL)`, then `update` once per tick
+ * of `1 / tick_hz` seconds elapsed since the last one (catching up at
+ * most 8 ticks after a stall), then `render` with the part of the next
+ * tick already elapsed, to interpolate between the last two simulated
+ * states. Until the next tick the thread sleeps, and spins only for the
+ * last `LAW_LOOP_SPIN_US` microseconds, so the ticks are on time at a
+ * fraction of the CPU of a `while (running) law_update(NULL);` loop.
+ * 
+ * @param update The function simulating a tick (`dt`, the tick in seconds, optional),
+ * @param render The function rendering a frame (`alpha` in [0, 1), optional),
+ * @param tick_hz The ticks per second (positive).
+ * @return The exit code of `law_exit`, 0 once every window of the display is destroyed,
+ *         or -1 if `tick_hz` isn't positive.
+ */
+int law_runLoop(void (*update)(double dt), void (*render)(double alpha), double tick_hz);
+
+/**
+ * @brief Set whether `law_update` waits while all windows are idle.
+ * 
+ * A window is idle once it's hidden or minimized (the `hide` event, or
+ * a resize to 0x0) until it's shown, maximized, focused or resized
+ * again. The `minimize` event is only a request, which a handler may
+ * refuse, so it doesn't make the window idle. When every window of the display is idle and
+ * no event is waiting, `law_update` (and so `law_runLoop`) blocks until
+ * the next native event or `law_postEventFromThread`, instead of
+ * returning at once. `law_updateFor` never waits.
+ * 
+ * @param enabled Non-zero to wait (the default), 0 to always return at once.
+ * 
+ * @note The headless backend has no native events, it only waits if
+ * enabled explicitly (woken by `law_postEventFromThread`).
+ */
+void law_setIdleWait(int enabled);
+
 /**
  * @brief Initialize the events structure with empty functions.
  * 
@@ -367,20 +984,54 @@ void law_initEvents(law_Events* events) {
   events->window.maximize = NULL;
   events->window.show = NULL;
   events->window.hide = NULL;
+  events->window.created = NULL;
   events->window.file_drop = NULL;
+#ifndef LAW_NO_TOUCH
   events->window.touch = NULL;
+#endif
 
   events->key.down = NULL;
   events->key.up = NULL;
+#ifndef LAW_NO_TEXT
+  events->key.text = NULL;
+#endif
 
+#ifndef LAW_NO_MOUSE
   events->mouse.move = NULL;
   events->mouse.down = NULL;
   events->mouse.up = NULL;
   events->mouse.wheel = NULL;
+#endif
 
+#ifndef LAW_NO_PEN
   events->pen = NULL;
+  events->pen_batch = NULL;
+#endif
 }
 
+#if !defined(LAW_NO_MOUSE) || !defined(LAW_NO_PEN)
+#define __LAW_HAS_POINTER // The mouse or the pen is read, their positions are recorded
+/**
+ * @brief Predict the position of the pointer.
+ * 
+ * Extrapolates the position of the mouse or pen `ms_ahead` milliseconds
+ * past its latest sample, using the velocity fitted to the timestamped
+ * samples of the last few milliseconds. Drawing applications can render
+ * predicted ink to hide a frame of display latency.
+ * 
+ * @param window The window,
+ * @param ms_ahead How far to predict (milliseconds),
+ * @param x The predicted x position of the pointer in the client area,
+ * @param y The predicted y position of the pointer in the client area.
+ * @return Non-zero if the position was written, 0 if the pointer has not moved
+ *         over the window yet.
+ * 
+ * @note The error grows quickly with `ms_ahead`; predicting one frame
+ * (8-16 ms) ahead is usually the sweet spot.
+ */
+int law_getPredictedPointer(law_Window window, int ms_ahead, int* x, int* y);
+#endif // LAW_NO_MOUSE && LAW_NO_PEN
+
 #pragma endregion _events
 
 #pragma region _errors
@@ -402,364 +1053,3035 @@ const char* law_getErrorMsg(unsigned int error_code);
 #pragma region Implementation
 
 
-
-
-// ------------------- Windows Implementation -------------------
-#pragma region win32
-#ifdef _WIN32  // Windows-specific includes and code
+// ------------------- Common Implementation -------------------
+#pragma region common
 
 // Define 'LA_WINDOW_IMPLEMENTATION' in your source file 
 // before including this header to create the implementation.
 #ifdef LA_WINDOW_IMPLEMENTATION
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
+#include <string.h> // For strlen, memcpy
+#include <wchar.h>  // For wcslen
 
-/* IF YOU ARE USING GOLINK, please, define <_GOLINK> macro (GoLink is a linker for Windows)
-        website: https://www.godevtool.com/
-        archive: http://web.archive.org/web/20240527134555/http://www.godevtool.com/
-        
-   Attention: You can use GetCommandLine() to get the command line arguments, -
-     - but you can't use argc and argv:    
+#pragma region _keys
 
-   LPSTR commandLine = GetCommandLine(); 
-   MessageBox(NULL, commandLine, "Command Line", MB_OK);   
+/*
+  Key translation tables.
+
+  Every table maps a native key code directly to `LAW_KEY_*`, so translating
+  a key is a single indexed load (0 is `LAW_KEY_UNKNOWN`).
+  `tests/test_keys.c` lists the native codes of every key and checks
+  every entry of the tables, update both together.
 */
-#if defined(_GOLINK) || defined(_MSC_VER) && !defined(_CONSOLE) // If using GoLink or MSVC without console
-  #define main(...) WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
-#endif // _GOLINK
 
-#define LA_KEY_LEFT 
+#define __LAW_K(key) LAW_KEY_##key
+
+// [0x000-0x0FF] virtual-key codes,
+// [0x100-0x1FF] extended virtual-key codes (the right shift key is selected by its scan code)
+static const unsigned short __law_keys_vk[512] = {
+  /* 0x000 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x008 */ __LAW_K(BACKSPACE), __LAW_K(TAB), 0, 0, 0, __LAW_K(ENTER), 0, 0,
+  /* 0x010 */ __LAW_K(LEFT_SHIFT), __LAW_K(LEFT_CONTROL), __LAW_K(LEFT_ALT), __LAW_K(PAUSE), __LAW_K(CAPS_LOCK), 0, 0, 0,
+  /* 0x018 */ 0, 0, 0, __LAW_K(ESCAPE), 0, 0, 0, 0,
+  /* 0x020 */ __LAW_K(SPACE), __LAW_K(PAGE_UP), __LAW_K(PAGE_DOWN), __LAW_K(END), __LAW_K(HOME), __LAW_K(LEFT), __LAW_K(UP), __LAW_K(RIGHT),
+  /* 0x028 */ __LAW_K(DOWN), 0, 0, 0, __LAW_K(PRINT_SCREEN), __LAW_K(INSERT), __LAW_K(DELETE), 0,
+  /* 0x030 */ __LAW_K(0), __LAW_K(1), __LAW_K(2), __LAW_K(3), __LAW_K(4), __LAW_K(5), __LAW_K(6), __LAW_K(7),
+  /* 0x038 */ __LAW_K(8), __LAW_K(9), 0, 0, 0, 0, 0, 0,
+  /* 0x040 */ 0, __LAW_K(A), __LAW_K(B), __LAW_K(C), __LAW_K(D), __LAW_K(E), __LAW_K(F), __LAW_K(G),
+  /* 0x048 */ __LAW_K(H), __LAW_K(I), __LAW_K(J), __LAW_K(K), __LAW_K(L), __LAW_K(M), __LAW_K(N), __LAW_K(O),
+  /* 0x050 */ __LAW_K(P), __LAW_K(Q), __LAW_K(R), __LAW_K(S), __LAW_K(T), __LAW_K(U), __LAW_K(V), __LAW_K(W),
+  /* 0x058 */ __LAW_K(X), __LAW_K(Y), __LAW_K(Z), __LAW_K(LEFT_SUPER), __LAW_K(RIGHT_SUPER), __LAW_K(MENU), 0, 0,
+  /* 0x060 */ __LAW_K(KP_0), __LAW_K(KP_1), __LAW_K(KP_2), __LAW_K(KP_3), __LAW_K(KP_4), __LAW_K(KP_5), __LAW_K(KP_6), __LAW_K(KP_7),
+  /* 0x068 */ __LAW_K(KP_8), __LAW_K(KP_9), __LAW_K(KP_MULTIPLY), __LAW_K(KP_ADD), 0, __LAW_K(KP_SUBTRACT), __LAW_K(KP_DECIMAL), __LAW_K(KP_DIVIDE),
+  /* 0x070 */ __LAW_K(F1), __LAW_K(F2), __LAW_K(F3), __LAW_K(F4), __LAW_K(F5), __LAW_K(F6), __LAW_K(F7), __LAW_K(F8),
+  /* 0x078 */ __LAW_K(F9), __LAW_K(F10), __LAW_K(F11), __LAW_K(F12), 0, 0, 0, 0,
+  /* 0x080 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x088 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x090 */ __LAW_K(NUM_LOCK), __LAW_K(SCROLL_LOCK), 0, 0, 0, 0, 0, 0,
+  /* 0x098 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0A0 */ __LAW_K(LEFT_SHIFT), __LAW_K(RIGHT_SHIFT), __LAW_K(LEFT_CONTROL), __LAW_K(RIGHT_CONTROL), __LAW_K(LEFT_ALT), __LAW_K(RIGHT_ALT), 0, 0,
+  /* 0x0A8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B8 */ 0, 0, __LAW_K(SEMICOLON), __LAW_K(EQUAL), __LAW_K(COMMA), __LAW_K(MINUS), __LAW_K(PERIOD), __LAW_K(SLASH),
+  /* 0x0C0 */ __LAW_K(GRAVE), 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0C8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D8 */ 0, 0, 0, __LAW_K(LEFT_BRACKET), __LAW_K(BACKSLASH), __LAW_K(RIGHT_BRACKET), __LAW_K(APOSTROPHE), 0,
+  /* 0x0E0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0E8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x100 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x108 */ __LAW_K(BACKSPACE), __LAW_K(TAB), 0, 0, 0, __LAW_K(KP_ENTER), 0, 0,
+  /* 0x110 */ __LAW_K(RIGHT_SHIFT), __LAW_K(RIGHT_CONTROL), __LAW_K(RIGHT_ALT), __LAW_K(PAUSE), __LAW_K(CAPS_LOCK), 0, 0, 0,
+  /* 0x118 */ 0, 0, 0, __LAW_K(ESCAPE), 0, 0, 0, 0,
+  /* 0x120 */ __LAW_K(SPACE), __LAW_K(PAGE_UP), __LAW_K(PAGE_DOWN), __LAW_K(END), __LAW_K(HOME), __LAW_K(LEFT), __LAW_K(UP), __LAW_K(RIGHT),
+  /* 0x128 */ __LAW_K(DOWN), 0, 0, 0, __LAW_K(PRINT_SCREEN), __LAW_K(INSERT), __LAW_K(DELETE), 0,
+  /* 0x130 */ __LAW_K(0), __LAW_K(1), __LAW_K(2), __LAW_K(3), __LAW_K(4), __LAW_K(5), __LAW_K(6), __LAW_K(7),
+  /* 0x138 */ __LAW_K(8), __LAW_K(9), 0, 0, 0, 0, 0, 0,
+  /* 0x140 */ 0, __LAW_K(A), __LAW_K(B), __LAW_K(C), __LAW_K(D), __LAW_K(E), __LAW_K(F), __LAW_K(G),
+  /* 0x148 */ __LAW_K(H), __LAW_K(I), __LAW_K(J), __LAW_K(K), __LAW_K(L), __LAW_K(M), __LAW_K(N), __LAW_K(O),
+  /* 0x150 */ __LAW_K(P), __LAW_K(Q), __LAW_K(R), __LAW_K(S), __LAW_K(T), __LAW_K(U), __LAW_K(V), __LAW_K(W),
+  /* 0x158 */ __LAW_K(X), __LAW_K(Y), __LAW_K(Z), __LAW_K(LEFT_SUPER), __LAW_K(RIGHT_SUPER), __LAW_K(MENU), 0, 0,
+  /* 0x160 */ __LAW_K(KP_0), __LAW_K(KP_1), __LAW_K(KP_2), __LAW_K(KP_3), __LAW_K(KP_4), __LAW_K(KP_5), __LAW_K(KP_6), __LAW_K(KP_7),
+  /* 0x168 */ __LAW_K(KP_8), __LAW_K(KP_9), __LAW_K(KP_MULTIPLY), __LAW_K(KP_ADD), 0, __LAW_K(KP_SUBTRACT), __LAW_K(KP_DECIMAL), __LAW_K(KP_DIVIDE),
+  /* 0x170 */ __LAW_K(F1), __LAW_K(F2), __LAW_K(F3), __LAW_K(F4), __LAW_K(F5), __LAW_K(F6), __LAW_K(F7), __LAW_K(F8),
+  /* 0x178 */ __LAW_K(F9), __LAW_K(F10), __LAW_K(F11), __LAW_K(F12), 0, 0, 0, 0,
+  /* 0x180 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x188 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x190 */ __LAW_K(NUM_LOCK), __LAW_K(SCROLL_LOCK), 0, 0, 0, 0, 0, 0,
+  /* 0x198 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1A0 */ __LAW_K(LEFT_SHIFT), __LAW_K(RIGHT_SHIFT), __LAW_K(LEFT_CONTROL), __LAW_K(RIGHT_CONTROL), __LAW_K(LEFT_ALT), __LAW_K(RIGHT_ALT), 0, 0,
+  /* 0x1A8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1B0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1B8 */ 0, 0, __LAW_K(SEMICOLON), __LAW_K(EQUAL), __LAW_K(COMMA), __LAW_K(MINUS), __LAW_K(PERIOD), __LAW_K(SLASH),
+  /* 0x1C0 */ __LAW_K(GRAVE), 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1C8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1D0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1D8 */ 0, 0, 0, __LAW_K(LEFT_BRACKET), __LAW_K(BACKSLASH), __LAW_K(RIGHT_BRACKET), __LAW_K(APOSTROPHE), 0,
+  /* 0x1E0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1E8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1F0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1F8 */ 0, 0, 0, 0, 0, 0, 0, 0
+};
 
-#pragma region _events
+// [0x000-0x0FF] Latin-1 keysyms, [0x100-0x1FF] 0xFFxx keysyms
+static const unsigned short __law_keys_keysym[512] = {
+  /* 0x000 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x008 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x010 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x018 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x020 */ __LAW_K(SPACE), 0, 0, 0, 0, 0, 0, __LAW_K(APOSTROPHE),
+  /* 0x028 */ 0, 0, 0, 0, __LAW_K(COMMA), __LAW_K(MINUS), __LAW_K(PERIOD), __LAW_K(SLASH),
+  /* 0x030 */ __LAW_K(0), __LAW_K(1), __LAW_K(2), __LAW_K(3), __LAW_K(4), __LAW_K(5), __LAW_K(6), __LAW_K(7),
+  /* 0x038 */ __LAW_K(8), __LAW_K(9), 0, __LAW_K(SEMICOLON), 0, __LAW_K(EQUAL), 0, 0,
+  /* 0x040 */ 0, __LAW_K(A), __LAW_K(B), __LAW_K(C), __LAW_K(D), __LAW_K(E), __LAW_K(F), __LAW_K(G),
+  /* 0x048 */ __LAW_K(H), __LAW_K(I), __LAW_K(J), __LAW_K(K), __LAW_K(L), __LAW_K(M), __LAW_K(N), __LAW_K(O),
+  /* 0x050 */ __LAW_K(P), __LAW_K(Q), __LAW_K(R), __LAW_K(S), __LAW_K(T), __LAW_K(U), __LAW_K(V), __LAW_K(W),
+  /* 0x058 */ __LAW_K(X), __LAW_K(Y), __LAW_K(Z), __LAW_K(LEFT_BRACKET), __LAW_K(BACKSLASH), __LAW_K(RIGHT_BRACKET), 0, 0,
+  /* 0x060 */ __LAW_K(GRAVE), __LAW_K(A), __LAW_K(B), __LAW_K(C), __LAW_K(D), __LAW_K(E), __LAW_K(F), __LAW_K(G),
+  /* 0x068 */ __LAW_K(H), __LAW_K(I), __LAW_K(J), __LAW_K(K), __LAW_K(L), __LAW_K(M), __LAW_K(N), __LAW_K(O),
+  /* 0x070 */ __LAW_K(P), __LAW_K(Q), __LAW_K(R), __LAW_K(S), __LAW_K(T), __LAW_K(U), __LAW_K(V), __LAW_K(W),
+  /* 0x078 */ __LAW_K(X), __LAW_K(Y), __LAW_K(Z), 0, 0, 0, 0, 0,
+  /* 0x080 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x088 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x090 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x098 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0A0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0A8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0C0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0C8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0E0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0E8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x100 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x108 */ __LAW_K(BACKSPACE), __LAW_K(TAB), 0, 0, 0, __LAW_K(ENTER), 0, 0,
+  /* 0x110 */ 0, 0, 0, __LAW_K(PAUSE), __LAW_K(SCROLL_LOCK), 0, 0, 0,
+  /* 0x118 */ 0, 0, 0, __LAW_K(ESCAPE), 0, 0, 0, 0,
+  /* 0x120 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x128 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x130 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x138 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x140 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x148 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x150 */ __LAW_K(HOME), __LAW_K(LEFT), __LAW_K(UP), __LAW_K(RIGHT), __LAW_K(DOWN), __LAW_K(PAGE_UP), __LAW_K(PAGE_DOWN), __LAW_K(END),
+  /* 0x158 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x160 */ 0, __LAW_K(PRINT_SCREEN), 0, __LAW_K(INSERT), 0, 0, 0, __LAW_K(MENU),
+  /* 0x168 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x170 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x178 */ 0, 0, 0, 0, 0, 0, 0, __LAW_K(NUM_LOCK),
+  /* 0x180 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x188 */ 0, 0, 0, 0, 0, __LAW_K(KP_ENTER), 0, 0,
+  /* 0x190 */ 0, 0, 0, 0, 0, __LAW_K(KP_7), __LAW_K(KP_4), __LAW_K(KP_8),
+  /* 0x198 */ __LAW_K(KP_6), __LAW_K(KP_2), __LAW_K(KP_9), __LAW_K(KP_3), __LAW_K(KP_1), __LAW_K(KP_5), __LAW_K(KP_0), __LAW_K(KP_DECIMAL),
+  /* 0x1A0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1A8 */ 0, 0, __LAW_K(KP_MULTIPLY), __LAW_K(KP_ADD), 0, __LAW_K(KP_SUBTRACT), __LAW_K(KP_DECIMAL), __LAW_K(KP_DIVIDE),
+  /* 0x1B0 */ __LAW_K(KP_0), __LAW_K(KP_1), __LAW_K(KP_2), __LAW_K(KP_3), __LAW_K(KP_4), __LAW_K(KP_5), __LAW_K(KP_6), __LAW_K(KP_7),
+  /* 0x1B8 */ __LAW_K(KP_8), __LAW_K(KP_9), 0, 0, 0, __LAW_K(KP_EQUAL), __LAW_K(F1), __LAW_K(F2),
+  /* 0x1C0 */ __LAW_K(F3), __LAW_K(F4), __LAW_K(F5), __LAW_K(F6), __LAW_K(F7), __LAW_K(F8), __LAW_K(F9), __LAW_K(F10),
+  /* 0x1C8 */ __LAW_K(F11), __LAW_K(F12), 0, 0, 0, 0, 0, 0,
+  /* 0x1D0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1D8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1E0 */ 0, __LAW_K(LEFT_SHIFT), __LAW_K(RIGHT_SHIFT), __LAW_K(LEFT_CONTROL), __LAW_K(RIGHT_CONTROL), __LAW_K(CAPS_LOCK), 0, 0,
+  /* 0x1E8 */ 0, __LAW_K(LEFT_ALT), __LAW_K(RIGHT_ALT), __LAW_K(LEFT_SUPER), __LAW_K(RIGHT_SUPER), 0, 0, 0,
+  /* 0x1F0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x1F8 */ 0, 0, 0, 0, 0, 0, 0, __LAW_K(DELETE)
+};
 
-// macro 'EVENT' will be undefined after wrappers below
-#define EVENT ((law_Events*)GetWindowLongPtrW(window, GWLP_USERDATA))
+// Linux evdev key codes
+static const unsigned short __law_keys_evdev[256] = {
+  /* 0x000 */ 0, __LAW_K(ESCAPE), __LAW_K(1), __LAW_K(2), __LAW_K(3), __LAW_K(4), __LAW_K(5), __LAW_K(6),
+  /* 0x008 */ __LAW_K(7), __LAW_K(8), __LAW_K(9), __LAW_K(0), __LAW_K(MINUS), __LAW_K(EQUAL), __LAW_K(BACKSPACE), __LAW_K(TAB),
+  /* 0x010 */ __LAW_K(Q), __LAW_K(W), __LAW_K(E), __LAW_K(R), __LAW_K(T), __LAW_K(Y), __LAW_K(U), __LAW_K(I),
+  /* 0x018 */ __LAW_K(O), __LAW_K(P), __LAW_K(LEFT_BRACKET), __LAW_K(RIGHT_BRACKET), __LAW_K(ENTER), __LAW_K(LEFT_CONTROL), __LAW_K(A), __LAW_K(S),
+  /* 0x020 */ __LAW_K(D), __LAW_K(F), __LAW_K(G), __LAW_K(H), __LAW_K(J), __LAW_K(K), __LAW_K(L), __LAW_K(SEMICOLON),
+  /* 0x028 */ __LAW_K(APOSTROPHE), __LAW_K(GRAVE), __LAW_K(LEFT_SHIFT), __LAW_K(BACKSLASH), __LAW_K(Z), __LAW_K(X), __LAW_K(C), __LAW_K(V),
+  /* 0x030 */ __LAW_K(B), __LAW_K(N), __LAW_K(M), __LAW_K(COMMA), __LAW_K(PERIOD), __LAW_K(SLASH), __LAW_K(RIGHT_SHIFT), __LAW_K(KP_MULTIPLY),
+  /* 0x038 */ __LAW_K(LEFT_ALT), __LAW_K(SPACE), __LAW_K(CAPS_LOCK), __LAW_K(F1), __LAW_K(F2), __LAW_K(F3), __LAW_K(F4), __LAW_K(F5),
+  /* 0x040 */ __LAW_K(F6), __LAW_K(F7), __LAW_K(F8), __LAW_K(F9), __LAW_K(F10), __LAW_K(NUM_LOCK), __LAW_K(SCROLL_LOCK), __LAW_K(KP_7),
+  /* 0x048 */ __LAW_K(KP_8), __LAW_K(KP_9), __LAW_K(KP_SUBTRACT), __LAW_K(KP_4), __LAW_K(KP_5), __LAW_K(KP_6), __LAW_K(KP_ADD), __LAW_K(KP_1),
+  /* 0x050 */ __LAW_K(KP_2), __LAW_K(KP_3), __LAW_K(KP_0), __LAW_K(KP_DECIMAL), 0, 0, 0, __LAW_K(F11),
+  /* 0x058 */ __LAW_K(F12), 0, 0, 0, 0, 0, 0, 0,
+  /* 0x060 */ __LAW_K(KP_ENTER), __LAW_K(RIGHT_CONTROL), __LAW_K(KP_DIVIDE), __LAW_K(PRINT_SCREEN), __LAW_K(RIGHT_ALT), 0, __LAW_K(HOME), __LAW_K(UP),
+  /* 0x068 */ __LAW_K(PAGE_UP), __LAW_K(LEFT), __LAW_K(RIGHT), __LAW_K(END), __LAW_K(DOWN), __LAW_K(PAGE_DOWN), __LAW_K(INSERT), __LAW_K(DELETE),
+  /* 0x070 */ 0, 0, 0, 0, 0, __LAW_K(KP_EQUAL), 0, __LAW_K(PAUSE),
+  /* 0x078 */ 0, 0, 0, 0, 0, __LAW_K(LEFT_SUPER), __LAW_K(RIGHT_SUPER), __LAW_K(MENU),
+  /* 0x080 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x088 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x090 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x098 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0A0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0A8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0B8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0C0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0C8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0D8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0E0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0E8 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F0 */ 0, 0, 0, 0, 0, 0, 0, 0,
+  /* 0x0F8 */ 0, 0, 0, 0, 0, 0, 0, 0
+};
 
-static LRESULT CALLBACK __law_wrapperCreate(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  // Allocating memory for the window parameters
-  law_Data* win_data = (law_Data*)malloc(sizeof(law_Data));
-  if (win_data == NULL) {
-    assert(0 && "Failed to allocate memory for window parameters");
-    DestroyWindow((HWND)window);
-    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
-    return 0;
-  }
-  // Setting the events
-  law_initEvents((law_Events*)win_data); // Initialize the events with empty functions
-  win_data->running = 1; // Window is running by default
-  win_data->user_data = NULL; // User data is NULL by default
+#undef __LAW_K
 
-  // Setting the user data
-  SetWindowLongPtrW((HWND)window, GWLP_USERDATA, (LONG_PTR)win_data);
-  return 0;
+int law_keyFromVk(unsigned int vk, int extended) {
+  return vk < 0x100 ? __law_keys_vk[(extended ? 0x100 : 0) | vk] : LAW_KEY_UNKNOWN;
 }
-static LRESULT CALLBACK __law_wrapperDestroy(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.destroy)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.destroy((law_Window)window, win_data);
+int law_keyFromKeysym(unsigned long keysym) {
+  if (keysym < 0x100)
+    return __law_keys_keysym[keysym];
+  if ((keysym & ~0xFFUL) == 0xFF00)
+    return __law_keys_keysym[0x100 | (keysym & 0xFF)];
+  return LAW_KEY_UNKNOWN;
+}
 
-  // Freeing the memory
-  free(win_data);
-  
-  return 0;
+int law_keyFromEvdev(unsigned int code) {
+  return code < 0x100 ? __law_keys_evdev[code] : LAW_KEY_UNKNOWN;
 }
-static LRESULT CALLBACK __law_wrapperClose(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.close)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.close((law_Window)window, win_data);
+#pragma endregion _keys
+
+// The rest needs a backend (Windows, or `LAW_HEADLESS` on any platform)
+#if defined(_WIN32) || defined(LAW_HEADLESS)
+
+#pragma region _threads
+
+// Atomics (32-bit integers)
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+  #define __LAW_LOAD_ACQUIRE(pointer) ((unsigned int)_InterlockedOr((volatile long*)(pointer), 0))
+  #define __LAW_STORE_RELEASE(pointer, value) _InterlockedExchange((volatile long*)(pointer), (long)(value))
+  #define __LAW_EXCHANGE(pointer, value) _InterlockedExchange((volatile long*)(pointer), (long)(value))
+  #define __LAW_FETCH_ADD(pointer, value) ((unsigned int)_InterlockedExchangeAdd((volatile long*)(pointer), (long)(value)))
+  #define __LAW_PAUSE() _mm_pause()
+  #define __LAW_FENCE() _mm_mfence()
+#else
+  #define __LAW_LOAD_ACQUIRE(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+  #define __LAW_STORE_RELEASE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+  #define __LAW_EXCHANGE(pointer, value) __atomic_exchange_n((pointer), (value), __ATOMIC_ACQUIRE)
+  #define __LAW_FETCH_ADD(pointer, value) __atomic_fetch_add((pointer), (value), __ATOMIC_RELAXED)
+  #define __LAW_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+  #if defined(__x86_64__) || defined(__i386__)
+    #define __LAW_PAUSE() __builtin_ia32_pause()
+  #else
+    #define __LAW_PAUSE() ((void)0)
+  #endif
+#endif
 
-  return 0;
+// Spin lock for the short critical sections of the worker threads
+static void __law_spinLock(int* lock) {
+  while (__LAW_EXCHANGE(lock, 1))
+    while (__LAW_LOAD_ACQUIRE(lock))
+      __LAW_PAUSE();
 }
-static LRESULT CALLBACK __law_wrapperResize(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.resize)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.resize((law_Window)window, win_data, LOWORD(lParam), HIWORD(lParam));
-  return 0;
+static void __law_spinUnlock(int* lock) {
+  __LAW_STORE_RELEASE(lock, 0);
 }
-static LRESULT CALLBACK __law_wrapperMove(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.move)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.move((law_Window)window, win_data, LOWORD(lParam), HIWORD(lParam));
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperFocus(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.focus)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+// Threads, mutexes and condition variables
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+
+  typedef HANDLE __law_Thread;
+  typedef SRWLOCK __law_Mutex;
+  typedef CONDITION_VARIABLE __law_Cond;
+  #define __LAW_MUTEX_INITIALIZER SRWLOCK_INIT
+  #define __LAW_COND_INITIALIZER CONDITION_VARIABLE_INIT
+  #define __LAW_THREAD_RESULT DWORD WINAPI
+  #define __LAW_THREAD_RETURN 0
+
+  static int __law_threadStart(__law_Thread* thread, DWORD (WINAPI *function)(void*), void* argument) {
+    *thread = CreateThread(NULL, 0, function, argument, 0, NULL);
+    return *thread != NULL;
+  }
+  static void __law_threadJoin(__law_Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+  }
+  static void __law_mutexInit(__law_Mutex* mutex) { InitializeSRWLock(mutex); }
+  static void __law_mutexDestroy(__law_Mutex* mutex) { (void)mutex; }
+  static void __law_mutexLock(__law_Mutex* mutex) { AcquireSRWLockExclusive(mutex); }
+  static void __law_mutexUnlock(__law_Mutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+  static void __law_condInit(__law_Cond* cond) { InitializeConditionVariable(cond); }
+  static void __law_condDestroy(__law_Cond* cond) { (void)cond; }
+  static void __law_condWait(__law_Cond* cond, __law_Mutex* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+  static void __law_condBroadcast(__law_Cond* cond) { WakeAllConditionVariable(cond); }
+#else
+  #include <pthread.h>
+
+  typedef pthread_t __law_Thread;
+  typedef pthread_mutex_t __law_Mutex;
+  typedef pthread_cond_t __law_Cond;
+  #define __LAW_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+  #define __LAW_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+  #define __LAW_THREAD_RESULT void*
+  #define __LAW_THREAD_RETURN NULL
+
+  static int __law_threadStart(__law_Thread* thread, void* (*function)(void*), void* argument) {
+    return pthread_create(thread, NULL, function, argument) == 0;
+  }
+  static void __law_threadJoin(__law_Thread thread) { pthread_join(thread, NULL); }
+  static void __law_mutexInit(__law_Mutex* mutex) { pthread_mutex_init(mutex, NULL); }
+  static void __law_mutexDestroy(__law_Mutex* mutex) { pthread_mutex_destroy(mutex); }
+  static void __law_mutexLock(__law_Mutex* mutex) { pthread_mutex_lock(mutex); }
+  static void __law_mutexUnlock(__law_Mutex* mutex) { pthread_mutex_unlock(mutex); }
+  static void __law_condInit(__law_Cond* cond) { pthread_cond_init(cond, NULL); }
+  static void __law_condDestroy(__law_Cond* cond) { pthread_cond_destroy(cond); }
+  static void __law_condWait(__law_Cond* cond, __law_Mutex* mutex) { pthread_cond_wait(cond, mutex); }
+  static void __law_condBroadcast(__law_Cond* cond) { pthread_cond_broadcast(cond); }
+#endif
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.focus((law_Window)window, win_data);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperUnfocus(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.unfocus)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+#pragma endregion _threads
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.unfocus((law_Window)window, win_data);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperRedraw(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.redraw)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+// Current time in microseconds (monotonic), implemented by the platform
+static unsigned long long __law_now(void);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->window.redraw((law_Window)window, win_data);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperKeyDown(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->key.down)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+#ifdef __LAW_HAS_POINTER
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->key.down((law_Window)window, win_data, (int)wParam);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperKeyUp(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->key.up)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+// Number of pointer samples kept for the prediction
+#define __LAW_POINTER_HISTORY 16
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->key.up((law_Window)window, win_data, (int)wParam);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperMouseMove(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.move)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+// Only samples this recent (microseconds) are used for the prediction
+#define __LAW_POINTER_WINDOW 50000
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.move((law_Window)window, win_data, LOWORD(lParam), HIWORD(lParam));
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperLButtonDown(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.down)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+// Source of a pointer sample
+enum {
+  __LAW_POINTER_MOUSE = 0,
+  __LAW_POINTER_PEN,
+};
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.down((law_Window)window, win_data, LAW_MOUSE_LEFT);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperRButtonDown(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.down)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+typedef struct {
+  int x, y;                // Position in the client area
+  unsigned long long time; // Time of the sample (microseconds)
+  int source;              // __LAW_POINTER_MOUSE or __LAW_POINTER_PEN
+} __law_PointerSample;
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.down((law_Window)window, win_data, LAW_MOUSE_RIGHT);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperMButtonDown(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.down)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+#endif // __LAW_HAS_POINTER
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.down((law_Window)window, win_data, LAW_MOUSE_MIDDLE);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperXButtonDown(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.down)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
+/*
+  Priority lanes.
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.down((law_Window)window, win_data, GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? LAW_MOUSE_X1 : LAW_MOUSE_X2);
-  return 0;
+  The queued events of a window are delivered lane by lane: the input
+  first, then the window-state events, so a burst of window events can
+  not delay the input behind it. The redraw is not queued, all requests
+  of an update are merged into one, delivered after every other event
+  of all windows (see `__law_flushPending`).
+*/
+enum {
+  __LAW_LANE_INPUT = 0, // Keys, text, mouse, pen, touch
+  __LAW_LANE_WINDOW,    // Close, resize, move, focus, minimize, ...
+  __LAW_LANE_COUNT
+};
+
+// Queue of events waiting to be dispatched
+typedef struct {
+  law_Event* events;
+  size_t count;    // Number of events in `events`
+  size_t next;     // Index of the next event to dispatch
+  size_t capacity; // Capacity of `events`
+} __law_Queue;
+
+// Property changes recorded by `law_beginUpdate`
+enum {
+  __LAW_CHANGE_POS = 1,
+  __LAW_CHANGE_SIZE = 2,
+  __LAW_CHANGE_TITLE = 4,
+};
+
+typedef struct {
+  unsigned int depth;   // Nesting of `law_beginUpdate` (0 outside of a transaction)
+  unsigned int changes; // Recorded changes (__LAW_CHANGE_*)
+  int x, y;             // New position
+  int width, height;    // New size
+  wchar_t* title;       // New title (NULL for an empty one)
+} __law_Transaction;
+
+/**
+ * @brief Internal state of a window.
+ * 
+ * `law_Data` is the first member, so a `law_Data*` returned by
+ * `law_getData(law_Window)` can be cast to `__law_State*` and back.
+ */
+typedef struct __law_State {
+  law_Data data;     // Public data of the window (must be the first member)
+  law_Window window; // The window owning this state
+  struct __law_Display* display; // Display connection of the window (see `law_openDisplay`)
+
+#ifndef LAW_NO_PEN
+  law_PenSample* pen_samples; // Pen samples waiting for the `pen_batch` event
+  size_t pen_count;           // Number of pen samples waiting
+  size_t pen_capacity;        // Capacity of `pen_samples`
+#endif
+
+#ifdef __LAW_HAS_POINTER
+  __law_PointerSample pointers[__LAW_POINTER_HISTORY]; // Latest pointer samples (ring buffer)
+  unsigned int pointer_head;                           // Index of the latest pointer sample
+  unsigned int pointer_count;                          // Number of recorded pointer samples
+#endif
+
+  __law_Queue lanes[__LAW_LANE_COUNT]; // Events waiting to be dispatched, by priority
+  unsigned char redraw;                // Non-zero if a redraw is requested
+  unsigned long long redraw_time;      // Time of the first redraw request
+  struct __law_State* next_redraw;     // Next window waiting for its redraw
+
+#ifndef LAW_NO_TEXT
+  char* text;              // Typed text waiting for the `text` event (UTF-8)
+  size_t text_length;      // Length of `text` (without the zero-terminator)
+  size_t text_capacity;    // Capacity of `text`
+  unsigned short text_surrogate; // Pending high surrogate of an UTF-16 character (Windows)
+#endif
+
+  __law_FuncWinDataEvent handler; // Handler of the event types in `handler_mask` (see `law_setEventHandler`)
+  unsigned int handler_mask;      // Event types delivered to `handler` (LAW_EVENT_MASK)
+  __law_FuncWinDataEvents batch_handler; // Handler of all events (see `law_setBatchHandler`)
+  __law_Queue batch;                     // Events being delivered to `batch_handler`
+
+  __law_Transaction transaction; // Property changes waiting for `law_commitUpdate`
+
+#ifndef LAW_NO_CURSOR
+  law_Cursor cursor; // Cursor over the client area (NULL for the default one)
+#endif
+
+#ifndef LAW_NO_FRAMEBUFFER
+  struct __law_Render* render;     // Render thread of the window (see `law_startRenderThread`)
+  struct __law_State* next_render; // Next window of the display with a render thread
+#endif
+
+  struct __law_State* next_created; // Next window of the display waiting for its `created` event
+  unsigned char creating;           // Non-zero while in the created list (see `law_createManyAsync`)
+  unsigned char created_show;       // Non-zero to show the window when it's announced
+
+  struct __law_State* next_pooled; // Next window of the pool of the display
+  int pool_kind;                   // Kind of the window (see `law_acquirePooledWindow`)
+  unsigned char pooled;            // Non-zero while the window is in the pool
+  int origin_x, origin_y;          // Position of the new window, restored when pooled
+
+  struct __law_State* next_pending; // Next window with undelivered batched events
+  unsigned char pending;            // Non-zero if the window is in the pending list
+  unsigned char flushing;           // Non-zero while the batched events are being delivered
+  unsigned char destroyed;          // Non-zero if the window was destroyed while flushing
+  unsigned char idle;               // Non-zero while the window is hidden or minimized
+} __law_State;
+
+// State of the window, implemented by the platform (NULL if the window does not exist)
+static __law_State* __law_lookup(law_Window window);
+
+#pragma region _registry
+
+/*
+  Native handle -> window state registry.
+
+  Windows keeps the state of a window in GWLP_USERDATA, but IDs like
+  X11 windows or the headless windows have no such slot. The registry is
+  an open-addressing hash table (linear probing, power-of-two capacity)
+  with backward-shift deletion, so there are no tombstones and lookups
+  stay short however many windows are created and destroyed.
+*/
+
+typedef struct {
+  size_t key;         // Native ID (0 marks an empty slot)
+  __law_State* state; // State of the window
+} __law_RegistryEntry;
+
+typedef struct {
+  __law_RegistryEntry* entries;
+  size_t capacity; // Power of two (or 0)
+  size_t count;
+} __law_Registry;
+
+// Home slot of the key (Fibonacci hashing, sequential IDs spread over the table)
+static size_t __law_registryHome(const __law_Registry* registry, size_t key) {
+  return (size_t)(((unsigned long long)key * 0x9E3779B97F4A7C15ull) >> 32) & (registry->capacity - 1);
+}
+
+static __law_State* __law_registryFind(const __law_Registry* registry, size_t key) {
+  if (registry->count == 0)
+    return NULL;
+
+  size_t mask = registry->capacity - 1;
+  for (size_t i = __law_registryHome(registry, key);; i = (i + 1) & mask) {
+    if (registry->entries[i].key == key)
+      return registry->entries[i].state;
+    if (registry->entries[i].key == 0)
+      return NULL;
+  }
+}
+
+static int __law_registryInsert(__law_Registry* registry, size_t key, __law_State* state) {
+  assert(key != 0 && "Native IDs can not be 0");
+
+  // Keeping the load factor under 1/2
+  if ((registry->count + 1) * 2 > registry->capacity) {
+    size_t capacity = registry->capacity ? registry->capacity * 2 : 64;
+    __law_RegistryEntry* entries = (__law_RegistryEntry*)calloc(capacity, sizeof(__law_RegistryEntry));
+    if (entries == NULL)
+      return 0;
+
+    __law_Registry grown = { entries, capacity, 0 };
+    for (size_t i = 0; i < registry->capacity; i++)
+      if (registry->entries[i].key)
+        __law_registryInsert(&grown, registry->entries[i].key, registry->entries[i].state);
+
+    free(registry->entries);
+    *registry = grown;
+  }
+
+  size_t mask = registry->capacity - 1;
+  size_t i = __law_registryHome(registry, key);
+  while (registry->entries[i].key != 0 && registry->entries[i].key != key)
+    i = (i + 1) & mask;
+
+  if (registry->entries[i].key == 0)
+    registry->count++;
+  registry->entries[i].key = key;
+  registry->entries[i].state = state;
+  return 1;
+}
+
+static void __law_registryRemove(__law_Registry* registry, size_t key) {
+  if (registry->count == 0)
+    return;
+
+  size_t mask = registry->capacity - 1;
+  size_t i = __law_registryHome(registry, key);
+  while (registry->entries[i].key != key) {
+    if (registry->entries[i].key == 0)
+      return; // Not registered
+    i = (i + 1) & mask;
+  }
+
+  // Backward-shift deletion: the following entries of the cluster are moved
+  // into the hole unless their home slot lies (cyclically) after the hole
+  for (size_t j = (i + 1) & mask; registry->entries[j].key != 0; j = (j + 1) & mask) {
+    size_t home = __law_registryHome(registry, registry->entries[j].key);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      registry->entries[i] = registry->entries[j];
+      i = j;
+    }
+  }
+  registry->entries[i].key = 0;
+  registry->entries[i].state = NULL;
+  registry->count--;
+}
+
+#pragma endregion _registry
+
+#pragma region _displays
+
+/*
+  Display connections (see `law_openDisplay`).
+
+  Everything `law_update` works on (the pending and redraw lists, the
+  time budget, the dispatch pool) belongs to a connection, and a
+  connection to a single thread, so the threads of different connections
+  take no locks. A window keeps the connection it was created on.
+*/
+
+#if defined(_MSC_VER)
+  #define __LAW_THREAD_LOCAL __declspec(thread)
+#else
+  #define __LAW_THREAD_LOCAL __thread
+#endif
+
+/*
+  Single-producer single-consumer ring handing the events of another
+  thread (`law_postEventFromThread`) over to `law_update`, one per display.
+  The producer only writes `tail`, the consumer only writes `head`,
+  the indices wrap around and are masked with the size.
+*/
+
+#ifndef LAW_INPUT_RING_SIZE
+  #define LAW_INPUT_RING_SIZE 1024 // Capacity of the input ring of a display (power of two)
+#endif
+
+typedef struct {
+  law_Window window;
+  law_Event event;
+} __law_InputEntry;
+
+typedef struct {
+  unsigned int tail;                  // Next entry written by the producer
+  char padding[64 - sizeof(unsigned int)]; // `head` and `tail` on different cache lines
+  unsigned int head;                  // Next entry read by the consumer
+  int waiting;                        // Non-zero while the thread of the display waits (see `__law_idleWait`)
+  __law_InputEntry entries[LAW_INPUT_RING_SIZE];
+} __law_InputRing;
+
+typedef struct __law_Display {
+  char* name;     // Name of the connection (NULL for the default one)
+  size_t windows; // Number of live windows
+  size_t idle;    // Number of hidden or minimized windows (see `law_setIdleWait`)
+
+  // End of the time budget of the update (microseconds, 0 for none), see `law_updateFor`
+  unsigned long long deadline;
+  int budget_spent; // Non-zero if the budget ran out
+
+  // Windows with batched events waiting to be delivered at the end of `law_update`
+  __law_State* pending_list;
+  // Windows waiting for their redraw at the end of `law_update`,
+  // and the ones requesting it again while redrawing (redrawn by the next update)
+  __law_State* redraw_list;
+  __law_State* redraw_deferred;
+  int redrawing; // Non-zero while the redraws of all windows run
+
+  // Non-zero while the windows are dispatched in parallel (see `law_setDispatchThreads`),
+  // the pending and redraw lists are then shared by the threads
+  int parallel;
+  int lists_lock;
+  struct __law_Pool* pool; // Threads of the parallel dispatch (NULL if serial)
+
+#ifndef LAW_NO_FRAMEBUFFER
+  __law_State* render_list; // Windows with a render thread, presented by `law_update`
+#endif
+
+  __law_State* created_list; // Windows of `law_createManyAsync` announced by the next `law_update` (newest first)
+
+  __law_State* pool_list; // Hidden windows waiting for `law_acquirePooledWindow`
+  size_t pooled;          // Number of windows in `pool_list`
+
+  int exited;    // Non-zero once `law_update` processed `law_exit` (stops `law_runLoop`)
+  int exit_code; // Exit code of `law_exit`
+
+#ifdef LAW_HEADLESS
+  __law_Registry registry; // Live windows by ID
+  int quit;                // Non-zero if `law_exit` was called
+  int quit_code;
+#elif defined(_WIN32)
+  int monitor;      // Non-zero if the windows are placed on the monitor of the connection
+  int monitor_x, monitor_y;
+  unsigned long thread; // Thread of the connection, woken by `law_postEventFromThread`
+#endif
+
+  __law_InputRing input; // Events of `law_postEventFromThread`
+} __law_Display;
+
+static __law_Display __law_default_display;
+static __LAW_THREAD_LOCAL __law_Display* __law_thread_display = NULL; // Opened by the thread
+
+// Prepare the connection to the display named `display->name`, implemented by the platform
+static int __law_initDisplay(__law_Display* display);
+
+// Sleep until about `deadline` (microseconds, `__law_now`), returning early by
+// the precision of the sleep, implemented by the platform
+static void __law_sleepUntil(unsigned long long deadline);
+
+// Display of the calling thread
+static __law_Display* __law_currentDisplay(void) {
+  __law_Display* display = __law_thread_display;
+  return display ? display : &__law_default_display;
+}
+
+// Non-zero if the time budget of the update is spent
+static int __law_isOverBudget(__law_Display* display) {
+  if (display->deadline == 0)
+    return 0;
+  // Read by all threads of the parallel dispatch
+  if (!__LAW_LOAD_ACQUIRE(&display->budget_spent) && __law_now() >= display->deadline)
+    __LAW_STORE_RELEASE(&display->budget_spent, 1);
+  return (int)__LAW_LOAD_ACQUIRE(&display->budget_spent);
+}
+
+static void __law_lockLists(__law_Display* display) {
+  if (display->parallel)
+    __law_spinLock(&display->lists_lock);
+}
+
+static void __law_unlockLists(__law_Display* display) {
+  if (display->parallel)
+    __law_spinUnlock(&display->lists_lock);
+}
+
+#pragma endregion _displays
+
+static void __law_markPending(__law_State* state) {
+  if (state->pending)
+    return;
+
+  __law_Display* display = state->display;
+  __law_lockLists(display);
+  state->pending = 1;
+  state->next_pending = display->pending_list;
+  display->pending_list = state;
+  __law_unlockLists(display);
+}
+
+static void __law_unmarkPending(__law_State* state) {
+  if (!state->pending)
+    return;
+
+  __law_Display* display = state->display;
+  __law_lockLists(display);
+  __law_State** link = &display->pending_list;
+  while (*link != state)
+    link = &(*link)->next_pending;
+
+  *link = state->next_pending;
+  state->next_pending = NULL;
+  state->pending = 0;
+  __law_unlockLists(display);
+}
+
+static void __law_requestRedraw(__law_State* state, unsigned long long time) {
+  if (state->redraw)
+    return;
+
+  __law_Display* display = state->display;
+  __law_lockLists(display);
+  __law_State** list = display->redrawing ? &display->redraw_deferred : &display->redraw_list;
+  state->redraw = 1;
+  state->redraw_time = time;
+  state->next_redraw = *list;
+  *list = state;
+  __law_unlockLists(display);
+}
+
+static void __law_cancelRedraw(__law_State* state) {
+  if (!state->redraw)
+    return;
+
+  __law_Display* display = state->display;
+  __law_lockLists(display);
+  __law_State** link = &display->redraw_list;
+  while (*link && *link != state)
+    link = &(*link)->next_redraw;
+  if (*link == NULL) {
+    link = &display->redraw_deferred;
+    while (*link != state)
+      link = &(*link)->next_redraw;
+  }
+
+  *link = state->next_redraw;
+  state->next_redraw = NULL;
+  state->redraw = 0;
+  __law_unlockLists(display);
+}
+
+// Reserve the next event of the queue (NULL if out of memory)
+static law_Event* __law_queuePush(__law_Queue* queue) {
+  if (queue->count == queue->capacity) {
+    size_t capacity = queue->capacity ? queue->capacity * 2 : 64;
+    law_Event* events = (law_Event*)realloc(queue->events, capacity * sizeof(law_Event));
+    if (events == NULL) {
+      assert(0 && "Failed to allocate memory for events");
+      law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+      return NULL;
+    }
+    queue->events = events;
+    queue->capacity = capacity;
+  }
+  return &queue->events[queue->count++];
+}
+
+#ifndef LAW_NO_PEN
+static void __law_pushPenSample(__law_State* state, const law_PenSample* sample) {
+  if (state->pen_count == state->pen_capacity) {
+    size_t capacity = state->pen_capacity ? state->pen_capacity * 2 : 64;
+    law_PenSample* samples = (law_PenSample*)realloc(state->pen_samples, capacity * sizeof(law_PenSample));
+    if (samples == NULL) {
+      assert(0 && "Failed to allocate memory for pen samples");
+      law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+      return;
+    }
+    state->pen_samples = samples;
+    state->pen_capacity = capacity;
+  }
+
+  state->pen_samples[state->pen_count++] = *sample;
+  __law_markPending(state);
+}
+#endif
+
+#ifdef __LAW_HAS_POINTER
+static void __law_recordPointer(__law_State* state, int x, int y, unsigned long long time, int source) {
+  // While the pen moves, the mouse messages are the ones synthesized for it
+  const __law_PointerSample* latest = &state->pointers[state->pointer_head];
+  if (source == __LAW_POINTER_MOUSE && state->pointer_count && latest->source == __LAW_POINTER_PEN
+      && time <= latest->time + __LAW_POINTER_WINDOW)
+    return;
+
+  state->pointer_head = (state->pointer_head + 1) % __LAW_POINTER_HISTORY;
+  if (state->pointer_count < __LAW_POINTER_HISTORY)
+    state->pointer_count++;
+
+  __law_PointerSample* sample = &state->pointers[state->pointer_head];
+  sample->x = x;
+  sample->y = y;
+  sample->time = time;
+  sample->source = source;
+}
+
+int law_getPredictedPointer(law_Window window, int ms_ahead, int* x, int* y) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->pointer_count == 0)
+    return 0;
+
+  const __law_PointerSample* latest = &state->pointers[state->pointer_head];
+  *x = latest->x;
+  *y = latest->y;
+
+  // The pointer is resting, nothing to extrapolate
+  if (ms_ahead <= 0 || __law_now() - latest->time > __LAW_POINTER_WINDOW)
+    return 1;
+
+  // Least squares fit of the velocity over the recent samples of the same
+  // source (the mouse messages synthesized for a pen would only add noise)
+  double n = 0, st = 0, sx = 0, sy = 0, stt = 0, stx = 0, sty = 0;
+  for (unsigned int i = 0; i < state->pointer_count; i++) {
+    unsigned int index = (state->pointer_head + __LAW_POINTER_HISTORY - i) % __LAW_POINTER_HISTORY;
+    const __law_PointerSample* sample = &state->pointers[index];
+    if (sample->source != latest->source || latest->time - sample->time > __LAW_POINTER_WINDOW)
+      break;
+
+    double t = -(double)(latest->time - sample->time) / 1000.0; // milliseconds, 0 for the latest sample
+    n += 1;
+    st += t;
+    sx += sample->x;
+    sy += sample->y;
+    stt += t * t;
+    stx += t * sample->x;
+    sty += t * sample->y;
+  }
+
+  double denominator = n * stt - st * st;
+  if (n < 2 || denominator < 1e-6) // Not enough samples or all at the same time
+    return 1;
+
+  double velocity_x = (n * stx - st * sx) / denominator; // pixels per millisecond
+  double velocity_y = (n * sty - st * sy) / denominator;
+
+  *x = latest->x + (int)(velocity_x * ms_ahead + (velocity_x < 0 ? -0.5 : 0.5));
+  *y = latest->y + (int)(velocity_y * ms_ahead + (velocity_y < 0 ? -0.5 : 0.5));
+  return 1;
+}
+#endif // __LAW_HAS_POINTER
+
+#ifndef LAW_NO_TEXT
+// Append a character to the typed text (encoded as UTF-8)
+static void __law_pushText(__law_State* state, unsigned int codepoint) {
+  if (state->text_length + 5 > state->text_capacity) { // 4 bytes + zero-terminator
+    size_t capacity = state->text_capacity ? state->text_capacity * 2 : 64;
+    char* text = (char*)realloc(state->text, capacity);
+    if (text == NULL) {
+      assert(0 && "Failed to allocate memory for text");
+      law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+      return;
+    }
+    state->text = text;
+    state->text_capacity = capacity;
+  }
+
+  char* out = state->text + state->text_length;
+  if (codepoint < 0x80) {
+    out[0] = (char)codepoint;
+    state->text_length += 1;
+  }
+  else if (codepoint < 0x800) {
+    out[0] = (char)(0xC0 | (codepoint >> 6));
+    out[1] = (char)(0x80 | (codepoint & 0x3F));
+    state->text_length += 2;
+  }
+  else if (codepoint < 0x10000) {
+    out[0] = (char)(0xE0 | (codepoint >> 12));
+    out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[2] = (char)(0x80 | (codepoint & 0x3F));
+    state->text_length += 3;
+  }
+  else {
+    out[0] = (char)(0xF0 | (codepoint >> 18));
+    out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (codepoint & 0x3F));
+    state->text_length += 4;
+  }
+  __law_markPending(state);
+}
+#endif
+
+static void __law_freeState(__law_State* state) {
+  for (int lane = 0; lane < __LAW_LANE_COUNT; lane++)
+    free(state->lanes[lane].events);
+  free(state->batch.events);
+  free(state->transaction.title);
+#ifndef LAW_NO_PEN
+  free(state->pen_samples);
+#endif
+#ifndef LAW_NO_TEXT
+  free(state->text);
+#endif
+  free(state);
+}
+
+// Follow the visibility of the window (see `law_setIdleWait`)
+static void __law_setIdle(__law_State* state, int idle) {
+  if (state->idle == idle)
+    return;
+  state->idle = (unsigned char)idle;
+  // Shared by the threads of the parallel dispatch
+  __law_Display* display = state->display;
+  __law_lockLists(display);
+  if (idle)
+    display->idle++;
+  else
+    display->idle--;
+  __law_unlockLists(display);
+}
+
+static void __law_trackIdle(__law_State* state, const law_Event* event) {
+  switch (event->type) {
+  case LAW_EVENT_HIDE: __law_setIdle(state, 1); break;
+  case LAW_EVENT_SHOW:
+  case LAW_EVENT_MAXIMIZE:
+  case LAW_EVENT_FOCUS: __law_setIdle(state, 0); break;
+  case LAW_EVENT_RESIZE: __law_setIdle(state, event->size.width == 0 && event->size.height == 0); break;
+  }
+}
+
+law_Data* law_getData(law_Window window) {
+  return (law_Data*)__law_lookup(window);
+}
+
+void law_setEventHandler(law_Window window, __law_FuncWinDataEvent handler, unsigned int mask) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL)
+    return;
+
+  state->handler = mask ? handler : NULL;
+  state->handler_mask = handler ? mask & LAW_EVENT_MASK_ALL : 0;
+}
+
+void law_setBatchHandler(law_Window window, __law_FuncWinDataEvents handler) {
+  __law_State* state = __law_lookup(window);
+  if (state)
+    state->batch_handler = handler;
+}
+
+// Event types delivered as `law_Event` (to the batch handler or the event handler) instead of the callbacks
+static unsigned int __law_eventMask(const __law_State* state) {
+  return state->batch_handler ? LAW_EVENT_MASK_ALL : state->handler_mask;
+}
+
+// Non-zero if the window has a handler for the event type
+static int __law_isHandled(const __law_State* state, int type) {
+  if (__law_eventMask(state) & LAW_EVENT_MASK(type))
+    return 1;
+
+  const law_Events* events = &state->data.event;
+  switch (type) {
+  case LAW_EVENT_DESTROY: return events->window.destroy != NULL;
+  case LAW_EVENT_CLOSE: return events->window.close != NULL;
+  case LAW_EVENT_RESIZE: return events->window.resize != NULL;
+  case LAW_EVENT_MOVE: return events->window.move != NULL;
+  case LAW_EVENT_FOCUS: return events->window.focus != NULL;
+  case LAW_EVENT_UNFOCUS: return events->window.unfocus != NULL;
+  case LAW_EVENT_REDRAW: return events->window.redraw != NULL;
+  case LAW_EVENT_MINIMIZE: return events->window.minimize != NULL;
+  case LAW_EVENT_MAXIMIZE: return events->window.maximize != NULL;
+  case LAW_EVENT_SHOW: return events->window.show != NULL;
+  case LAW_EVENT_HIDE: return events->window.hide != NULL;
+  case LAW_EVENT_CREATED: return events->window.created != NULL;
+#ifndef LAW_NO_TOUCH
+  case LAW_EVENT_TOUCH: return events->window.touch != NULL;
+#endif
+  case LAW_EVENT_KEY_DOWN: return events->key.down != NULL;
+  case LAW_EVENT_KEY_UP: return events->key.up != NULL;
+#ifndef LAW_NO_TEXT
+  case LAW_EVENT_TEXT: return events->key.text != NULL;
+#endif
+#ifndef LAW_NO_MOUSE
+  case LAW_EVENT_MOUSE_MOVE: return events->mouse.move != NULL;
+  case LAW_EVENT_MOUSE_DOWN: return events->mouse.down != NULL;
+  case LAW_EVENT_MOUSE_UP: return events->mouse.up != NULL;
+  case LAW_EVENT_MOUSE_WHEEL: return events->mouse.wheel != NULL;
+#endif
+#ifndef LAW_NO_PEN
+  case LAW_EVENT_PEN: return events->pen != NULL || events->pen_batch != NULL;
+#endif
+  default: return 0;
+  }
+}
+
+// Call the handler of the event (handlers may be removed after the event was queued)
+static void __law_dispatch(__law_State* state, const law_Event* event) {
+  law_Events* events = &state->data.event;
+  law_Window window = state->window;
+  law_Data* data = &state->data;
+
+  if (state->batch_handler) {
+    state->batch_handler(window, data, event, 1);
+    return;
+  }
+  if (state->handler_mask & LAW_EVENT_MASK(event->type)) {
+    state->handler(window, data, event);
+    return;
+  }
+
+  switch (event->type) {
+  case LAW_EVENT_DESTROY: if (events->window.destroy) events->window.destroy(window, data); break;
+  case LAW_EVENT_CLOSE: if (events->window.close) events->window.close(window, data); break;
+  case LAW_EVENT_RESIZE: if (events->window.resize) events->window.resize(window, data, event->size.width, event->size.height); break;
+  case LAW_EVENT_MOVE: if (events->window.move) events->window.move(window, data, event->pos.x, event->pos.y); break;
+  case LAW_EVENT_FOCUS: if (events->window.focus) events->window.focus(window, data); break;
+  case LAW_EVENT_UNFOCUS: if (events->window.unfocus) events->window.unfocus(window, data); break;
+  case LAW_EVENT_REDRAW: if (events->window.redraw) events->window.redraw(window, data); break;
+  case LAW_EVENT_MINIMIZE: if (events->window.minimize) events->window.minimize(window, data); break;
+  case LAW_EVENT_MAXIMIZE: if (events->window.maximize) events->window.maximize(window, data); break;
+  case LAW_EVENT_SHOW: if (events->window.show) events->window.show(window, data); break;
+  case LAW_EVENT_HIDE: if (events->window.hide) events->window.hide(window, data); break;
+  case LAW_EVENT_CREATED: if (events->window.created) events->window.created(window, data); break;
+#ifndef LAW_NO_TOUCH
+  case LAW_EVENT_TOUCH: if (events->window.touch) events->window.touch(window, data, event->pos.x, event->pos.y); break;
+#endif
+  case LAW_EVENT_KEY_DOWN: if (events->key.down) events->key.down(window, data, event->key); break;
+  case LAW_EVENT_KEY_UP: if (events->key.up) events->key.up(window, data, event->key); break;
+#ifndef LAW_NO_MOUSE
+  case LAW_EVENT_MOUSE_MOVE: if (events->mouse.move) events->mouse.move(window, data, event->pos.x, event->pos.y); break;
+  case LAW_EVENT_MOUSE_DOWN: if (events->mouse.down) events->mouse.down(window, data, event->button); break;
+  case LAW_EVENT_MOUSE_UP: if (events->mouse.up) events->mouse.up(window, data, event->button); break;
+  case LAW_EVENT_MOUSE_WHEEL: if (events->mouse.wheel) events->mouse.wheel(window, data, event->wheel); break;
+#endif
+#ifndef LAW_NO_PEN
+  case LAW_EVENT_PEN:
+    if (events->pen)
+      events->pen(window, data, event->pen.id, event->pen.pressure, event->pen.tilt_x, event->pen.tilt_y);
+    break;
+#endif
+  default: break;
+  }
+}
+
+// Event of the type with every other field zeroed
+static law_Event __law_event(int type) {
+  law_Event event;
+  memset(&event, 0, sizeof(event));
+  event.type = type;
+  return event;
+}
+
+// Non-zero if a new event of this type replaces the previous one in the queue
+static int __law_isCoalesced(int type) {
+  return type == LAW_EVENT_MOUSE_MOVE || type == LAW_EVENT_RESIZE || type == LAW_EVENT_MOVE;
+}
+
+// Priority lane of the event type
+static int __law_lane(int type) {
+  return type >= LAW_EVENT_TOUCH ? __LAW_LANE_INPUT : __LAW_LANE_WINDOW;
+}
+
+// Event types of the subsystems stripped at compile time (`LAW_NO_*`)
+#ifdef LAW_NO_TOUCH
+  #define __LAW_STRIPPED_TOUCH LAW_EVENT_MASK(LAW_EVENT_TOUCH)
+#else
+  #define __LAW_STRIPPED_TOUCH 0
+#endif
+#ifdef LAW_NO_TEXT
+  #define __LAW_STRIPPED_TEXT LAW_EVENT_MASK(LAW_EVENT_TEXT)
+#else
+  #define __LAW_STRIPPED_TEXT 0
+#endif
+#ifdef LAW_NO_MOUSE
+  #define __LAW_STRIPPED_MOUSE (LAW_EVENT_MASK(LAW_EVENT_MOUSE_MOVE) | LAW_EVENT_MASK(LAW_EVENT_MOUSE_DOWN) \
+    | LAW_EVENT_MASK(LAW_EVENT_MOUSE_UP) | LAW_EVENT_MASK(LAW_EVENT_MOUSE_WHEEL))
+#else
+  #define __LAW_STRIPPED_MOUSE 0
+#endif
+#ifdef LAW_NO_PEN
+  #define __LAW_STRIPPED_PEN LAW_EVENT_MASK(LAW_EVENT_PEN)
+#else
+  #define __LAW_STRIPPED_PEN 0
+#endif
+#define __LAW_EVENT_MASK_STRIPPED (__LAW_STRIPPED_TOUCH | __LAW_STRIPPED_TEXT | __LAW_STRIPPED_MOUSE | __LAW_STRIPPED_PEN)
+
+int law_postEvent(law_Window window, const law_Event* event) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || event->type <= LAW_EVENT_DESTROY || event->type >= LAW_EVENT_COUNT
+    || (LAW_EVENT_MASK(event->type) & __LAW_EVENT_MASK_STRIPPED) || state->pooled)
+    return 0;
+
+  __law_trackIdle(state, event); // Even if the event is filtered
+
+  // Pointer history and pen samples are kept even if the event is filtered or coalesced
+  unsigned long long time = event->time;
+#ifdef __LAW_HAS_POINTER
+  if (event->type == LAW_EVENT_MOUSE_MOVE || event->type == LAW_EVENT_PEN)
+    time = time ? time : __law_now();
+#endif
+
+#ifndef LAW_NO_MOUSE
+  if (event->type == LAW_EVENT_MOUSE_MOVE)
+    __law_recordPointer(state, event->pos.x, event->pos.y, time, __LAW_POINTER_MOUSE);
+#endif
+#ifndef LAW_NO_PEN
+  if (event->type == LAW_EVENT_PEN) {
+    __law_recordPointer(state, event->pen.x, event->pen.y, time, __LAW_POINTER_PEN);
+    if (state->data.event.pen_batch) {
+      law_PenSample sample = { event->pen.id, event->pen.x, event->pen.y,
+        event->pen.pressure, event->pen.tilt_x, event->pen.tilt_y, time };
+      __law_pushPenSample(state, &sample);
+    }
+    if (!state->data.event.pen && !(__law_eventMask(state) & LAW_EVENT_MASK(LAW_EVENT_PEN))) // Only batched
+      return state->data.event.pen_batch != NULL;
+  }
+#endif
+#ifndef LAW_NO_TEXT
+  if (event->type == LAW_EVENT_TEXT && !(__law_eventMask(state) & LAW_EVENT_MASK(LAW_EVENT_TEXT))) {
+    // Batched with the rest of the text of the update
+    if (!state->data.event.key.text)
+      return 0;
+    __law_pushText(state, event->codepoint);
+    return 1;
+  }
+#endif
+
+  // Filtering
+  if (!__law_isHandled(state, event->type))
+    return 0;
+
+  if (!time)
+    time = __law_now();
+
+  // All redraw requests of an update are merged into one
+  if (event->type == LAW_EVENT_REDRAW) {
+    __law_requestRedraw(state, time);
+    return 1;
+  }
+
+  // Coalescing, with nothing in between (in the lane) the latest position or size replaces the previous one
+  __law_Queue* queue = &state->lanes[__law_lane(event->type)];
+  if (queue->count > queue->next && __law_isCoalesced(event->type)
+    && queue->events[queue->count - 1].type == event->type) {
+    queue->events[queue->count - 1] = *event;
+    queue->events[queue->count - 1].time = time;
+    return 1;
+  }
+
+  law_Event* queued = __law_queuePush(queue);
+  if (queued == NULL)
+    return 0;
+  *queued = *event;
+  queued->time = time;
+  __law_markPending(state);
+  return 1;
+}
+
+// Move the undelivered events to the front of the queue, merging the consecutive coalesced ones
+static void __law_compactQueue(__law_Queue* queue) {
+  size_t count = 0;
+  for (size_t i = queue->next; i < queue->count; i++) {
+    const law_Event* event = &queue->events[i];
+    if (count && __law_isCoalesced(event->type) && queue->events[count - 1].type == event->type)
+      queue->events[count - 1] = *event;
+    else
+      queue->events[count++] = *event;
+  }
+  queue->count = count;
+  queue->next = 0;
+}
+
+// Deliver the queued and batched events of the window, returns 0 if the window was destroyed
+static int __law_flushState(__law_State* state) {
+  __law_unmarkPending(state);
+  state->flushing = 1;
+
+  // Events posted by the handlers are dispatched in the same update,
+  // the input lane is always drained first
+  int over_budget = 0;
+  while (!state->destroyed) {
+    if (__law_isOverBudget(state->display)) {
+      over_budget = 1;
+      break;
+    }
+
+    __law_Queue* queue = NULL;
+    for (int lane = 0; lane < __LAW_LANE_COUNT && queue == NULL; lane++)
+      if (state->lanes[lane].next < state->lanes[lane].count)
+        queue = &state->lanes[lane];
+    if (queue == NULL)
+      break;
+
+    if (state->batch_handler) {
+      // The lane is swapped with the batch buffer, so the array stays valid
+      // while the handler posts new events
+      __law_Queue batch = *queue;
+      *queue = state->batch;
+      queue->count = queue->next = 0;
+      state->batch = batch;
+
+      state->batch_handler(state->window, &state->data, batch.events + batch.next, batch.count - batch.next);
+      continue;
+    }
+
+    law_Event event = queue->events[queue->next++];
+    __law_dispatch(state, &event);
+  }
+
+  if (over_budget) { // The backlog waits for the next update, with the batched events
+    for (int lane = 0; lane < __LAW_LANE_COUNT; lane++)
+      __law_compactQueue(&state->lanes[lane]);
+    state->flushing = 0;
+    __law_markPending(state);
+    return 1;
+  }
+
+  for (int lane = 0; lane < __LAW_LANE_COUNT; lane++)
+    state->lanes[lane].count = state->lanes[lane].next = 0;
+
+#ifndef LAW_NO_PEN
+  size_t pen_count = state->pen_count;
+  state->pen_count = 0;
+  if (pen_count && !state->destroyed && state->data.event.pen_batch)
+    state->data.event.pen_batch(state->window, &state->data, state->pen_samples, pen_count);
+#endif
+
+#ifndef LAW_NO_TEXT
+  size_t text_length = state->text_length;
+  state->text_length = 0;
+  if (text_length && !state->destroyed && state->data.event.key.text) {
+    state->text[text_length] = '\0';
+    state->data.event.key.text(state->window, &state->data, state->text);
+  }
+#endif
+
+  state->flushing = 0;
+  if (state->destroyed) { // The window was destroyed by one of the callbacks
+    __law_freeState(state);
+    return 0;
+  }
+  return 1;
+}
+
+// Dispatch the requested redraw of the window
+static void __law_redrawState(__law_State* state) {
+  law_Event event = __law_event(LAW_EVENT_REDRAW);
+  event.time = state->redraw_time;
+  __law_cancelRedraw(state);
+
+  state->flushing = 1;
+  __law_dispatch(state, &event);
+  state->flushing = 0;
+
+  if (state->destroyed)
+    __law_freeState(state);
+}
+
+#pragma region _input_ring
+
+// Display of the window, callable from any thread (NULL if the window doesn't exist),
+// implemented by the platform
+static __law_Display* __law_displayOf(law_Window window);
+
+// Wake the thread of the display waiting for events, implemented by the platform
+static void __law_wakeIdle(__law_Display* display);
+
+int law_postEventFromThread(law_Window window, const law_Event* event) {
+  __law_Display* display = __law_displayOf(window);
+  if (display == NULL)
+    return 0;
+
+  __law_InputRing* ring = &display->input;
+  unsigned int tail = ring->tail;
+  if (tail - __LAW_LOAD_ACQUIRE(&ring->head) == LAW_INPUT_RING_SIZE)
+    return 0; // Full
+
+  __law_InputEntry* entry = &ring->entries[tail & (LAW_INPUT_RING_SIZE - 1)];
+  entry->window = window;
+  entry->event = *event;
+  if (!entry->event.time)
+    entry->event.time = __law_now(); // Time of arrival
+
+  __LAW_STORE_RELEASE(&ring->tail, tail + 1);
+
+  __LAW_FENCE(); // The push is visible before the waiting flag is read (see `__law_idleWait`)
+  if (__LAW_LOAD_ACQUIRE(&ring->waiting))
+    __law_wakeIdle(display);
+  return 1;
+}
+
+// Non-zero if the ring of the display has events to post
+static int __law_inputPending(__law_Display* display) {
+  return __LAW_LOAD_ACQUIRE(&display->input.tail) != display->input.head;
+}
+
+// Post the events of the ring (thread of the display)
+static void __law_drainInput(__law_Display* display) {
+  __law_InputRing* ring = &display->input;
+  unsigned int head = ring->head;
+  unsigned int tail = __LAW_LOAD_ACQUIRE(&ring->tail);
+  if (head == tail)
+    return;
+
+  for (; head != tail; head++) {
+    __law_InputEntry* entry = &ring->entries[head & (LAW_INPUT_RING_SIZE - 1)];
+    law_postEvent(entry->window, &entry->event);
+  }
+  __LAW_STORE_RELEASE(&ring->head, head);
+}
+
+#pragma endregion _input_ring
+
+#pragma region _dispatch_pool
+
+/*
+  Work-stealing pool for the parallel dispatch.
+
+  The windows of a step are split evenly into one deque per thread;
+  a thread takes the windows of its deque from the front, and once it
+  is empty, steals from the back of the others. The windows are coarse
+  tasks, so a spin lock per deque is enough.
+*/
+
+#define __LAW_MAX_THREADS 64
+
+typedef struct {
+  struct __law_Pool* pool;
+  __law_State** tasks; // Windows of the deque (in the task array of the pool)
+  size_t front, back;  // Remaining windows [front, back)
+  int lock;
+  char padding[64];    // Deques on different cache lines
+} __law_Deque;
+
+typedef struct __law_Pool {
+  __law_Display* display;       // Display of the pool
+  int threads;                  // Threads dispatching, including the thread of the display
+  __law_Thread workers[__LAW_MAX_THREADS];
+  __law_Deque deques[__LAW_MAX_THREADS];
+  __law_Mutex mutex;
+  __law_Cond wake;              // Signaled when a step starts (or the pool stops)
+  __law_Cond done;              // Signaled when the last worker finished the step
+  unsigned int generation;      // Number of the step
+  int busy;                     // Workers still working on the step
+  int quit;
+  void (*job)(__law_State*);    // Run for every window of the step
+  __law_State** tasks;          // Windows of the step
+  size_t task_capacity;
+} __law_Pool;
+
+static __law_State* __law_dequePop(__law_Deque* deque, int steal) {
+  __law_State* state = NULL;
+  __law_spinLock(&deque->lock);
+  if (deque->front < deque->back)
+    state = steal ? deque->tasks[--deque->back] : deque->tasks[deque->front++];
+  __law_spinUnlock(&deque->lock);
+  return state;
+}
+
+// Run the job for the windows of the thread, then for the stolen ones
+static void __law_poolWork(__law_Pool* pool, int index) {
+  int threads = pool->threads;
+  for (;;) {
+    __law_State* state = __law_dequePop(&pool->deques[index], 0);
+    for (int i = 1; state == NULL && i < threads; i++)
+      state = __law_dequePop(&pool->deques[(index + i) % threads], 1);
+    if (state == NULL)
+      return;
+    pool->job(state);
+  }
+}
+
+static __LAW_THREAD_RESULT __law_poolWorker(void* argument) {
+  __law_Deque* deque = (__law_Deque*)argument;
+  __law_Pool* pool = deque->pool;
+  int index = (int)(deque - pool->deques);
+  unsigned int generation = 0;
+
+  __law_thread_display = pool->display; // The windows are looked up on the display of the pool
+
+  __law_mutexLock(&pool->mutex);
+  for (;;) {
+    while (!pool->quit && pool->generation == generation)
+      __law_condWait(&pool->wake, &pool->mutex);
+    if (pool->quit)
+      break;
+    generation = pool->generation;
+    __law_mutexUnlock(&pool->mutex);
+
+    __law_poolWork(pool, index);
+
+    __law_mutexLock(&pool->mutex);
+    if (--pool->busy == 0)
+      __law_condBroadcast(&pool->done);
+  }
+  __law_mutexUnlock(&pool->mutex);
+  return __LAW_THREAD_RETURN;
+}
+
+// Run `job` for every window of `tasks` on the pool, returns once all are done
+static void __law_poolRun(__law_Pool* pool, size_t count, void (*job)(__law_State*)) {
+  int threads = pool->threads;
+  for (int i = 0; i < threads; i++) {
+    pool->deques[i].tasks = pool->tasks;
+    pool->deques[i].front = count * i / threads;
+    pool->deques[i].back = count * (i + 1) / threads;
+  }
+
+  pool->display->parallel = 1;
+  __law_mutexLock(&pool->mutex);
+  pool->job = job;
+  pool->busy = threads - 1;
+  pool->generation++;
+  __law_condBroadcast(&pool->wake);
+  __law_mutexUnlock(&pool->mutex);
+
+  __law_poolWork(pool, 0); // The thread of the display is a worker too
+
+  __law_mutexLock(&pool->mutex);
+  while (pool->busy)
+    __law_condWait(&pool->done, &pool->mutex);
+  __law_mutexUnlock(&pool->mutex);
+  pool->display->parallel = 0;
+}
+
+// Collect the windows of a list (linked at `next_offset`) into the tasks of the pool,
+// returns the number of windows, 0 if the memory could not be allocated
+static size_t __law_poolCollect(__law_Pool* pool, __law_State* list, size_t next_offset) {
+  size_t count = 0;
+  for (__law_State* state = list; state; state = *(__law_State**)((char*)state + next_offset)) {
+    if (count == pool->task_capacity) {
+      size_t capacity = count ? count * 2 : 64;
+      __law_State** tasks = (__law_State**)realloc(pool->tasks, capacity * sizeof(__law_State*));
+      if (tasks == NULL) {
+        assert(0 && "Failed to allocate memory for the dispatch pool");
+        law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+        return 0;
+      }
+      pool->tasks = tasks;
+      pool->task_capacity = capacity;
+    }
+    pool->tasks[count++] = state;
+  }
+  return count;
+}
+
+// Stop the workers and free the pool
+static void __law_poolStop(__law_Pool* pool) {
+  __law_mutexLock(&pool->mutex);
+  pool->quit = 1;
+  __law_condBroadcast(&pool->wake);
+  __law_mutexUnlock(&pool->mutex);
+
+  for (int i = 1; i < pool->threads; i++)
+    __law_threadJoin(pool->workers[i]);
+
+  __law_condDestroy(&pool->wake);
+  __law_condDestroy(&pool->done);
+  __law_mutexDestroy(&pool->mutex);
+  free(pool->tasks);
+  free(pool);
+}
+
+int law_setDispatchThreads(int threads) {
+  __law_Display* display = __law_currentDisplay();
+  if (threads > __LAW_MAX_THREADS)
+    threads = __LAW_MAX_THREADS;
+  if (threads < 2)
+    threads = 0;
+  if (display->pool && display->pool->threads == threads)
+    return threads;
+
+  if (display->pool) {
+    __law_poolStop(display->pool);
+    display->pool = NULL;
+  }
+  if (threads == 0)
+    return 1;
+
+  __law_Pool* pool = (__law_Pool*)calloc(1, sizeof(__law_Pool));
+  if (pool == NULL) {
+    assert(0 && "Failed to allocate memory for the dispatch pool");
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return 1;
+  }
+  pool->display = display;
+  __law_mutexInit(&pool->mutex);
+  __law_condInit(&pool->wake);
+  __law_condInit(&pool->done);
+
+  pool->threads = 1;
+  for (int i = 1; i < threads; i++) {
+    pool->deques[i].pool = pool;
+    if (!__law_threadStart(&pool->workers[i], __law_poolWorker, &pool->deques[i]))
+      break;
+    pool->threads++;
+  }
+  pool->deques[0].pool = pool;
+
+  if (pool->threads == 1) { // No thread could be started
+    __law_poolStop(pool);
+    return 1;
+  }
+  display->pool = pool;
+  return pool->threads;
 }
-static LRESULT CALLBACK __law_wrapperLButtonUp(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.up)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.up((law_Window)window, win_data, LAW_MOUSE_LEFT);
-  return 0;
+// Jobs of the parallel steps
+static void __law_flushJob(__law_State* state) {
+  __law_flushState(state);
 }
-static LRESULT CALLBACK __law_wrapperRButtonUp(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.up)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.up((law_Window)window, win_data, LAW_MOUSE_RIGHT);
+static void __law_redrawJob(__law_State* state) {
+  __law_redrawState(state);
+}
+
+#pragma endregion _dispatch_pool
+
+#pragma region _render
+#ifndef LAW_NO_FRAMEBUFFER
+
+/*
+  Render threads (see `law_startRenderThread`).
+
+  Three frames rotate between the render thread and `law_update`:
+  `back` is rendered by the thread, `ready` is the latest finished frame
+  and `front` the presented one. Only the indices are swapped under the
+  mutex, a frame is resized by the thread owning it as `back`, so a
+  resize never reallocates a frame that is being read.
+*/
+
+// Show the frame in the client area of the window, implemented by the platform
+static void __law_presentFrame(__law_State* state, const law_Frame* frame);
+
+typedef struct {
+  law_Frame frame;
+  size_t capacity; // Capacity of `frame.pixels` (pixels)
+} __law_Buffer;
+
+typedef struct __law_Render {
+  __law_State* state;
+  law_RenderFunc render;
+  void* user;
+  __law_Thread thread;
+  __law_Mutex mutex;
+  __law_Cond changed;         // Signaled when a frame was taken, the size changed or the thread stops
+  __law_Buffer buffers[3];
+  int back, ready, front;     // Index of the rendered, latest finished and presented frames
+  int fresh;                  // Non-zero if `ready` was not presented yet
+  int width, height;          // Size of the next frame (the client area)
+  int quit;
+} __law_Render;
+
+// Size the frame for the next render (by the thread owning it)
+static int __law_resizeBuffer(__law_Buffer* buffer, int width, int height) {
+  size_t size = (size_t)width * (size_t)height;
+  if (size > buffer->capacity) {
+    unsigned int* pixels = (unsigned int*)malloc(size * sizeof(unsigned int));
+    if (pixels == NULL)
+      return 0;
+    free(buffer->frame.pixels);
+    buffer->frame.pixels = pixels;
+    buffer->capacity = size;
+  }
+  buffer->frame.width = width;
+  buffer->frame.height = height;
+  buffer->frame.stride = width;
+  return 1;
+}
+
+static __LAW_THREAD_RESULT __law_renderThreadMain(void* argument) {
+  __law_Render* render = (__law_Render*)argument;
+
+  __law_mutexLock(&render->mutex);
+  for (;;) {
+    // One frame ahead of the presentation at most, nothing to render without an area
+    while (!render->quit && (render->fresh || render->width <= 0 || render->height <= 0))
+      __law_condWait(&render->changed, &render->mutex);
+    if (render->quit)
+      break;
+    __law_Buffer* buffer = &render->buffers[render->back];
+    int width = render->width;
+    int height = render->height;
+    __law_mutexUnlock(&render->mutex);
+
+    int rendered = __law_resizeBuffer(buffer, width, height);
+    if (rendered)
+      render->render(render->state->window, &buffer->frame, render->user);
+
+    __law_mutexLock(&render->mutex);
+    if (!rendered) {
+      assert(0 && "Failed to allocate memory for the frame");
+      break;
+    }
+    int ready = render->ready;
+    render->ready = render->back;
+    render->back = ready;
+    render->fresh = 1;
+  }
+  __law_mutexUnlock(&render->mutex);
+  return __LAW_THREAD_RETURN;
+}
+
+int law_startRenderThread(law_Window window, law_RenderFunc render, void* user) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || render == NULL || state->render)
+    return 0;
+
+  __law_Render* thread = (__law_Render*)calloc(1, sizeof(__law_Render));
+  if (thread == NULL) {
+    assert(0 && "Failed to allocate memory for the render thread");
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return 0;
+  }
+  thread->state = state;
+  thread->render = render;
+  thread->user = user;
+  thread->back = 0;
+  thread->ready = 1;
+  thread->front = 2;
+  law_getSize(window, &thread->width, &thread->height);
+  __law_mutexInit(&thread->mutex);
+  __law_condInit(&thread->changed);
+
+  if (!__law_threadStart(&thread->thread, __law_renderThreadMain, thread)) {
+    __law_condDestroy(&thread->changed);
+    __law_mutexDestroy(&thread->mutex);
+    free(thread);
+    return 0;
+  }
+
+  state->render = thread;
+  state->next_render = state->display->render_list;
+  state->display->render_list = state;
+  return 1;
+}
+
+static void __law_stopRender(__law_State* state) {
+  __law_Render* render = state->render;
+  if (render == NULL)
+    return;
+
+  __law_mutexLock(&render->mutex);
+  render->quit = 1;
+  __law_condBroadcast(&render->changed);
+  __law_mutexUnlock(&render->mutex);
+  __law_threadJoin(render->thread);
+
+  __law_State** link = &state->display->render_list;
+  while (*link != state)
+    link = &(*link)->next_render;
+  *link = state->next_render;
+  state->next_render = NULL;
+  state->render = NULL;
+
+  for (int i = 0; i < 3; i++)
+    free(render->buffers[i].frame.pixels);
+  __law_condDestroy(&render->changed);
+  __law_mutexDestroy(&render->mutex);
+  free(render);
+}
+
+void law_stopRenderThread(law_Window window) {
+  __law_State* state = __law_lookup(window);
+  if (state)
+    __law_stopRender(state);
+}
+
+// Present the latest frames of the windows with a render thread (all if `window` is NULL),
+// and hand the size of the windows over to their next frames
+static void __law_presentFrames(__law_Display* display, law_Window window) {
+  for (__law_State* state = display->render_list; state; state = state->next_render) {
+    if (window && state->window != window)
+      continue;
+
+    __law_Render* render = state->render;
+    int width, height;
+    law_getSize(state->window, &width, &height);
+
+    __law_mutexLock(&render->mutex);
+    int fresh = render->fresh;
+    if (fresh) {
+      int front = render->front;
+      render->front = render->ready;
+      render->ready = front;
+      render->fresh = 0;
+    }
+    if (fresh || width != render->width || height != render->height) {
+      render->width = width;
+      render->height = height;
+      __law_condBroadcast(&render->changed);
+    }
+    __law_mutexUnlock(&render->mutex);
+
+    if (fresh)
+      __law_presentFrame(state, &render->buffers[render->front].frame);
+  }
+}
+
+#else // No render threads, nothing to stop or present
+
+static void __law_stopRender(__law_State* state) { (void)state; }
+static void __law_presentFrames(__law_Display* display, law_Window window) { (void)display; (void)window; }
+
+#endif // LAW_NO_FRAMEBUFFER
+#pragma endregion _render
+
+#pragma region _create_many
+
+// Windows shown by a single native operation
+#define __LAW_SHOW_BATCH 64
+
+// Show the windows together, implemented by the platform
+static void __law_showMany(const law_Window* windows, size_t count);
+
+size_t law_createMany(const law_CreateInfo* infos, size_t count, law_Window* windows) {
+  law_Window batch[__LAW_SHOW_BATCH];
+  size_t batch_count = 0;
+  size_t created = 0;
+  for (size_t i = 0; i < count; i++) {
+    windows[i] = law_create(infos[i].width, infos[i].height, infos[i].title, infos[i].parent);
+    if (windows[i] == NULL)
+      continue;
+    created++;
+
+    if (infos[i].show)
+      batch[batch_count++] = windows[i];
+    if (batch_count == __LAW_SHOW_BATCH) {
+      __law_showMany(batch, batch_count);
+      batch_count = 0;
+    }
+  }
+  if (batch_count)
+    __law_showMany(batch, batch_count);
+  return created;
+}
+
+size_t law_createManyAsync(const law_CreateInfo* infos, size_t count, law_Window* windows) {
+  __law_Display* display = __law_currentDisplay();
+  size_t created = 0;
+  for (size_t i = 0; i < count; i++) {
+    windows[i] = law_create(infos[i].width, infos[i].height, infos[i].title, infos[i].parent);
+    __law_State* state = windows[i] ? __law_lookup(windows[i]) : NULL;
+    if (state == NULL)
+      continue;
+    created++;
+
+    state->creating = 1;
+    state->created_show = infos[i].show != 0;
+    state->next_created = display->created_list;
+    display->created_list = state;
+  }
+  return created;
+}
+
+// Post the `created` events of the windows of `law_createManyAsync` and show them together
+static void __law_announceCreated(__law_Display* display) {
+  // In the order of creation
+  __law_State* list = NULL;
+  while (display->created_list) {
+    __law_State* state = display->created_list;
+    display->created_list = state->next_created;
+    state->next_created = list;
+    list = state;
+  }
+
+  law_Window batch[__LAW_SHOW_BATCH];
+  size_t batch_count = 0;
+  while (list) {
+    __law_State* state = list;
+    list = state->next_created;
+    state->next_created = NULL;
+    state->creating = 0;
+
+    law_Event event = __law_event(LAW_EVENT_CREATED);
+    law_postEvent(state->window, &event);
+
+    if (state->created_show)
+      batch[batch_count++] = state->window;
+    if (batch_count == __LAW_SHOW_BATCH || (list == NULL && batch_count)) {
+      __law_showMany(batch, batch_count);
+      batch_count = 0;
+    }
+  }
+}
+
+// Remove the window from the created list (destroyed before its announcement)
+static void __law_cancelCreated(__law_State* state) {
+  if (!state->creating)
+    return;
+
+  __law_State** link = &state->display->created_list;
+  while (*link != state)
+    link = &(*link)->next_created;
+  *link = state->next_created;
+  state->next_created = NULL;
+  state->creating = 0;
+}
+
+#pragma endregion _create_many
+
+#pragma region _transactions
+
+// Apply the recorded changes in one native operation, implemented by the platform
+static void __law_applyChanges(__law_State* state, const __law_Transaction* transaction);
+
+void law_beginUpdate(law_Window window) {
+  __law_State* state = __law_lookup(window);
+  if (state)
+    state->transaction.depth++;
+}
+
+void law_commitUpdate(law_Window window) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->transaction.depth == 0 || --state->transaction.depth)
+    return;
+
+  __law_Transaction transaction = state->transaction;
+  state->transaction.changes = 0;
+  state->transaction.title = NULL;
+  if (transaction.changes)
+    __law_applyChanges(state, &transaction);
+  free(transaction.title);
+}
+
+// Record the change if the window is in a transaction, returns 0 to apply it now
+static int __law_recordPos(law_Window window, int x, int y) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->transaction.depth == 0)
+    return 0;
+
+  state->transaction.changes |= __LAW_CHANGE_POS;
+  state->transaction.x = x;
+  state->transaction.y = y;
+  return 1;
+}
+
+static int __law_recordSize(law_Window window, int width, int height) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->transaction.depth == 0)
+    return 0;
+
+  state->transaction.changes |= __LAW_CHANGE_SIZE;
+  state->transaction.width = width;
+  state->transaction.height = height;
+  return 1;
+}
+
+static int __law_recordTitle(law_Window window, const wchar_t* title) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->transaction.depth == 0)
+    return 0;
+
+  wchar_t* copy = NULL;
+  if (title && title[0]) {
+    size_t length = wcslen(title);
+    copy = (wchar_t*)malloc((length + 1) * sizeof(wchar_t));
+    if (copy == NULL) {
+      assert(0 && "Failed to allocate memory for the title");
+      law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+      return 1;
+    }
+    memcpy(copy, title, (length + 1) * sizeof(wchar_t));
+  }
+
+  free(state->transaction.title);
+  state->transaction.changes |= __LAW_CHANGE_TITLE;
+  state->transaction.title = copy;
+  return 1;
+}
+
+#pragma endregion _transactions
+
+#pragma region _window_pool
+
+#ifndef LAW_WINDOW_POOL_SIZE
+  #define LAW_WINDOW_POOL_SIZE 16 // Windows kept by the pool of a display
+#endif
+
+law_Window law_acquirePooledWindow(int kind, int width, int height) {
+  __law_Display* display = __law_currentDisplay();
+  __law_State** link = &display->pool_list;
+  while (*link && (*link)->pool_kind != kind)
+    link = &(*link)->next_pooled;
+
+  if (*link == NULL) { // None of this kind
+    law_Window window = law_create(width, height, NULL, NULL);
+    __law_State* state = window ? __law_lookup(window) : NULL;
+    if (state)
+      state->pool_kind = kind;
+    return window;
+  }
+
+  __law_State* state = *link;
+  *link = state->next_pooled;
+  state->next_pooled = NULL;
+  state->pooled = 0;
+  display->pooled--;
+  display->windows++;
+
+  law_setSize(state->window, width, height);
+  return state->window;
+}
+
+void law_releasePooledWindow(law_Window window) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->pooled)
+    return;
+  __law_Display* display = state->display;
+  if (display->pooled >= LAW_WINDOW_POOL_SIZE) {
+    law_destroy(window);
+    return;
+  }
+
+  // The data of a new window, the events of the hide are filtered out
+  __law_stopRender(state);
+  law_initEvents(&state->data.event);
+  state->data.running = 1;
+  state->data.user_data = NULL;
+  state->handler = NULL;
+  state->handler_mask = 0;
+  state->batch_handler = NULL;
+  free(state->transaction.title);
+  memset(&state->transaction, 0, sizeof(state->transaction));
+  law_hide(window);
+  law_setTitle(window, NULL);
+  law_setPos(window, state->origin_x, state->origin_y);
+
+  // Nothing left for the next owner (the lanes may be read by `__law_flushState`
+  // if released by a handler, the emptied lanes end its loop)
+  for (int lane = 0; lane < __LAW_LANE_COUNT; lane++)
+    state->lanes[lane].count = state->lanes[lane].next = 0;
+#ifndef LAW_NO_PEN
+  state->pen_count = 0;
+#endif
+#ifndef LAW_NO_TEXT
+  state->text_length = 0;
+  state->text_surrogate = 0;
+#endif
+#ifdef __LAW_HAS_POINTER
+  state->pointer_count = 0;
+#endif
+#ifndef LAW_NO_CURSOR
+  law_setCursor(window, NULL);
+#endif
+  __law_unmarkPending(state);
+  __law_cancelRedraw(state);
+  __law_cancelCreated(state);
+  __law_setIdle(state, 0);
+
+  state->pooled = 1;
+  state->next_pooled = display->pool_list;
+  display->pool_list = state;
+  display->pooled++;
+  display->windows--;
+}
+
+// Remove the window from the pool (destroyed while pooled)
+static void __law_cancelPooled(__law_State* state) {
+  __law_State** link = &state->display->pool_list;
+  while (*link != state)
+    link = &(*link)->next_pooled;
+  *link = state->next_pooled;
+  state->next_pooled = NULL;
+  state->pooled = 0;
+  state->display->pooled--;
+  state->display->windows++; // Counted again, until the destroy
+}
+
+static void __law_clearPool(__law_Display* display) {
+  while (display->pool_list)
+    law_destroy(display->pool_list->window);
+}
+
+void law_clearWindowPool(void) {
+  __law_clearPool(__law_currentDisplay());
+}
+
+#pragma endregion _window_pool
+
+// Deliver the queued and batched events of the window, or of all windows if `window` is NULL,
+// followed by the redraws
+static void __law_flushPending(law_Window window) {
+  __law_Display* display = __law_currentDisplay();
+  __law_drainInput(display);
+  if (display->created_list)
+    __law_announceCreated(display);
+
+  if (window) {
+    __law_State* state = __law_lookup(window);
+    if (state && __law_flushState(state) && state->redraw && !__law_isOverBudget(display))
+      __law_redrawState(state);
+    __law_presentFrames(display, window);
+    return;
+  }
+
+  __law_Pool* pool = display->pool;
+  if (pool) {
+    // The pending windows are detached from the list and dispatched in parallel,
+    // the windows re-marked by their handlers make another step
+    while (display->pending_list && display->pending_list->next_pending && !__law_isOverBudget(display)) {
+      size_t count = __law_poolCollect(pool, display->pending_list, offsetof(__law_State, next_pending));
+      if (count == 0)
+        break;
+      for (size_t i = 0; i < count; i++) {
+        pool->tasks[i]->pending = 0;
+        pool->tasks[i]->next_pending = NULL;
+      }
+      display->pending_list = NULL;
+      __law_poolRun(pool, count, __law_flushJob);
+    }
+  }
+  while (display->pending_list && !__law_isOverBudget(display))
+    __law_flushState(display->pending_list);
+
+  // The redraws of all windows run last, once per update
+  display->redrawing = 1;
+  if (pool && display->redraw_list && display->redraw_list->next_redraw && !__law_isOverBudget(display)) {
+    size_t count = __law_poolCollect(pool, display->redraw_list, offsetof(__law_State, next_redraw));
+    if (count) {
+      for (size_t i = 0; i < count; i++) {
+        pool->tasks[i]->redraw = 0; // Detached, the redraw time is kept for the event
+        pool->tasks[i]->next_redraw = NULL;
+      }
+      display->redraw_list = NULL;
+      __law_poolRun(pool, count, __law_redrawJob);
+    }
+  }
+  while (display->redraw_list && !__law_isOverBudget(display))
+    __law_redrawState(display->redraw_list);
+  display->redrawing = 0;
+
+  // Redraws requested while redrawing are for the next update
+  while (display->redraw_deferred) {
+    __law_State* state = display->redraw_deferred;
+    display->redraw_deferred = state->next_redraw;
+    state->next_redraw = display->redraw_list;
+    display->redraw_list = state;
+  }
+
+  __law_presentFrames(display, NULL);
+}
+
+int law_updateFor(law_Window window, unsigned long long budget_ns) {
+  __law_Display* display = __law_currentDisplay();
+  display->deadline = __law_now() + budget_ns / 1000;
+  display->budget_spent = 0;
+  law_update(window);
+  display->deadline = 0;
+  return display->budget_spent;
+}
+
+// Process `law_exit`: call the exit function and stop `law_runLoop`
+static void __law_quit(__law_Display* display, int exit_code) {
+  display->exited = 1;
+  display->exit_code = exit_code;
+  if (__law_exit_func)
+    __law_exit_func(exit_code);
+}
+
+#ifndef LAW_LOOP_SPIN_US
+  #define LAW_LOOP_SPIN_US 200 // Spinning before a tick of `law_runLoop` (microseconds)
+#endif
+
+#define __LAW_LOOP_MAX_TICKS 8 // Ticks caught up after a stall, the rest is dropped
+
+// Sleep, then spin until `deadline` (microseconds, `__law_now`)
+static void __law_waitUntil(unsigned long long deadline) {
+  if (__law_now() + LAW_LOOP_SPIN_US < deadline)
+    __law_sleepUntil(deadline - LAW_LOOP_SPIN_US);
+  while (__law_now() < deadline)
+    __LAW_PAUSE();
+}
+
+int law_runLoop(void (*update)(double dt), void (*render)(double alpha), double tick_hz) {
+  if (!(tick_hz > 0)) { // Also NaN
+    assert(0 && "The tick rate must be positive");
+    return -1;
+  }
+
+  __law_Display* display = __law_currentDisplay();
+  unsigned long long tick = (unsigned long long)(1000000.0 / tick_hz + 0.5);
+  if (tick == 0)
+    tick = 1;
+  double dt = (double)tick / 1000000.0;
+
+  display->exited = 0;
+  unsigned long long next = __law_now() + tick; // Time of the next tick
+  for (;;) {
+    law_update(NULL);
+    if (display->exited)
+      return display->exit_code;
+    if (display->windows == 0)
+      return 0;
+
+    unsigned long long now = __law_now();
+    if (now >= next + tick * __LAW_LOOP_MAX_TICKS)
+      next = now - tick * (__LAW_LOOP_MAX_TICKS - 1); // Stalled, the older ticks are dropped
+    while (now >= next) {
+      if (update)
+        update(dt);
+      next += tick;
+    }
+
+    if (render) // `next` is within a tick after `now`
+      render((double)(tick - (next - now)) / (double)tick);
+    __law_waitUntil(next);
+  }
+}
+
+#ifdef LAW_HEADLESS
+  static int __law_idle_wait = 0; // Nothing but `law_postEventFromThread` could wake it up
+#else
+  static int __law_idle_wait = 1;
+#endif
+
+// Wait for the next native event, or for `law_postEventFromThread` on the display,
+// implemented by the platform
+static void __law_waitEvents(__law_Display* display);
+
+void law_setIdleWait(int enabled) {
+  __law_idle_wait = enabled != 0;
+}
+
+// Block until the next event if all windows of the display are idle (see `law_setIdleWait`),
+// called by `law_update` before reading the native events
+static void __law_idleWait(__law_Display* display) {
+  if (!__law_idle_wait || display->deadline || display->windows == 0 || display->idle < display->windows
+      || display->pending_list || display->redraw_list)
+    return;
+
+  // The flag is visible before the ring is checked, and the push before the flag is read
+  // (`law_postEventFromThread`), so an event pushed meanwhile is never missed
+  __LAW_STORE_RELEASE(&display->input.waiting, 1);
+  __LAW_FENCE();
+  if (!__law_inputPending(display))
+    __law_waitEvents(display);
+  __LAW_STORE_RELEASE(&display->input.waiting, 0);
+}
+
+law_Display law_openDisplay(const char* name) {
+  __law_Display* display = (__law_Display*)calloc(1, sizeof(__law_Display));
+  if (display == NULL) {
+    assert(0 && "Failed to allocate memory for the display");
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return NULL;
+  }
+
+  if (name) {
+    size_t length = strlen(name);
+    display->name = (char*)malloc(length + 1);
+    if (display->name == NULL) {
+      assert(0 && "Failed to allocate memory for the display");
+      law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+      free(display);
+      return NULL;
+    }
+    memcpy(display->name, name, length + 1);
+  }
+
+  if (!__law_initDisplay(display)) {
+    free(display->name);
+    free(display);
+    return NULL;
+  }
+
+  if (__law_thread_display)
+    law_closeDisplay(__law_thread_display);
+  __law_thread_display = display;
+  return display;
+}
+
+void law_closeDisplay(law_Display display) {
+  __law_Display* connection = (__law_Display*)display;
+  if (connection == NULL || connection == &__law_default_display)
+    return;
+  __law_clearPool(connection);
+  assert(connection->windows == 0 && "The windows of the display must be destroyed first");
+
+  if (connection->pool)
+    __law_poolStop(connection->pool);
+#ifdef LAW_HEADLESS
+  free(connection->registry.entries);
+#endif
+  free(connection->name);
+  if (__law_thread_display == connection)
+    __law_thread_display = NULL;
+  free(connection);
+}
+
+// Dispatch the destroy event and free the internal state of the window
+static void __law_destroyState(__law_State* state) {
+  if (state->pooled)
+    __law_cancelPooled(state);
+  __law_stopRender(state); // The frames may use the data freed by the handler
+
+  law_Event event = __law_event(LAW_EVENT_DESTROY);
+  __law_dispatch(state, &event);
+
+  __law_unmarkPending(state);
+  __law_cancelRedraw(state);
+  __law_cancelCreated(state);
+  __law_setIdle(state, 0);
+  state->display->windows--;
+  if (state->flushing)
+    state->destroyed = 1; // Freed once the delivery is finished
+  else
+    __law_freeState(state);
+}
+
+#endif // _WIN32 || LAW_HEADLESS
+#endif // LA_WINDOW_IMPLEMENTATION
+#pragma endregion common
+
+
+// ------------------- Windows Implementation -------------------
+#pragma region win32
+#if defined(_WIN32) && !defined(LAW_HEADLESS) // Windows-specific includes and code
+
+// Define 'LA_WINDOW_IMPLEMENTATION' in your source file 
+// before including this header to create the implementation.
+#ifdef LA_WINDOW_IMPLEMENTATION
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+/* IF YOU ARE USING GOLINK, please, define <_GOLINK> macro (GoLink is a linker for Windows)
+        website: https://www.godevtool.com/
+        archive: http://web.archive.org/web/20240527134555/http://www.godevtool.com/
+        
+   Attention: You can use GetCommandLine() to get the command line arguments, -
+     - but you can't use argc and argv:    
+
+   LPSTR commandLine = GetCommandLine(); 
+   MessageBox(NULL, commandLine, "Command Line", MB_OK);   
+*/
+#if defined(_GOLINK) || defined(_MSC_VER) && !defined(_CONSOLE) // If using GoLink or MSVC without console
+  #define main(...) WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
+#endif // _GOLINK
+
+#pragma region _api
+
+/*
+  user32 and gdi32 are loaded with LoadLibrary on the first `law_create`
+  (or `law_update`, ...) instead of being linked: a program that never
+  opens a window starts without them (loading user32 connects the
+  process to the window manager), and only kernel32 is linked.
+  The functions are called through `__law_api`, the names below are
+  redirected until the end of the implementation.
+  Define 'LAW_LINK_USER32' to link user32 and gdi32 as usual.
+*/
+
+#ifndef LAW_LINK_USER32
+
+// X(result, name, parameters, required)
+#define __LAW_USER32_API(X) \
+  X(LRESULT, DefWindowProcW, (HWND, UINT, WPARAM, LPARAM), 1) \
+  X(ATOM, RegisterClassW, (const WNDCLASSW*), 1) \
+  X(HWND, CreateWindowExW, (DWORD, LPCWSTR, LPCWSTR, DWORD, int, int, int, int, HWND, HMENU, HINSTANCE, LPVOID), 1) \
+  X(BOOL, DestroyWindow, (HWND), 1) \
+  X(BOOL, ShowWindow, (HWND, int), 1) \
+  X(BOOL, SetWindowPos, (HWND, HWND, int, int, int, int, UINT), 1) \
+  X(HDWP, BeginDeferWindowPos, (int), 1) \
+  X(HDWP, DeferWindowPos, (HDWP, HWND, HWND, int, int, int, int, UINT), 1) \
+  X(BOOL, EndDeferWindowPos, (HDWP), 1) \
+  X(BOOL, GetClientRect, (HWND, RECT*), 1) \
+  X(BOOL, GetWindowRect, (HWND, RECT*), 1) \
+  X(BOOL, SetWindowTextW, (HWND, LPCWSTR), 1) \
+  X(int, GetWindowTextW, (HWND, LPWSTR, int), 1) \
+  X(BOOL, ValidateRect, (HWND, const RECT*), 1) \
+  X(BOOL, ScreenToClient, (HWND, POINT*), 1) \
+  X(BOOL, GetCursorPos, (POINT*), 1) \
+  X(HWND, WindowFromPoint, (POINT), 1) \
+  X(HWND, GetForegroundWindow, (void), 1) \
+  X(HWND, GetAncestor, (HWND, UINT), 1) \
+  X(DWORD, GetWindowThreadProcessId, (HWND, DWORD*), 1) \
+  X(BOOL, PeekMessageW, (MSG*, HWND, UINT, UINT, UINT), 1) \
+  X(BOOL, GetMessageW, (MSG*, HWND, UINT, UINT), 1) \
+  X(BOOL, TranslateMessage, (const MSG*), 1) \
+  X(LRESULT, DispatchMessageW, (const MSG*), 1) \
+  X(BOOL, PostThreadMessageW, (DWORD, UINT, WPARAM, LPARAM), 1) \
+  X(void, PostQuitMessage, (int), 1) \
+  X(DWORD, MsgWaitForMultipleObjectsEx, (DWORD, const HANDLE*, DWORD, DWORD, DWORD), 1) \
+  X(BOOL, EnumDisplaySettingsExW, (LPCWSTR, DWORD, DEVMODEW*, DWORD), 1) \
+  X(BOOL, RegisterRawInputDevices, (const RAWINPUTDEVICE*, UINT, UINT), 1) \
+  X(UINT, GetRawInputData, (HRAWINPUT, UINT, LPVOID, UINT*, UINT), 1) \
+  __LAW_USER32_PTR_API(X) \
+  __LAW_USER32_TOUCH_API(X) \
+  __LAW_USER32_PEN_API(X) \
+  __LAW_USER32_FRAMEBUFFER_API(X) \
+  __LAW_USER32_CURSOR_API(X)
+
+// The *LongPtr functions are macros of the *Long ones on 32-bit Windows
+#ifdef _WIN64
+  #define __LAW_USER32_PTR_API(X) \
+    X(LONG_PTR, GetWindowLongPtrW, (HWND, int), 1) \
+    X(LONG_PTR, SetWindowLongPtrW, (HWND, int, LONG_PTR), 1) \
+    X(ULONG_PTR, GetClassLongPtrW, (HWND, int), 1)
+#else
+  #define __LAW_USER32_PTR_API(X) \
+    X(LONG, GetWindowLongW, (HWND, int), 1) \
+    X(LONG, SetWindowLongW, (HWND, int, LONG), 1) \
+    X(DWORD, GetClassLongW, (HWND, int), 1)
+#endif
+
+// Functions of the stripped subsystems (`LAW_NO_*`) are not loaded
+#ifndef LAW_NO_TOUCH
+  #define __LAW_USER32_TOUCH_API(X) \
+    X(BOOL, GetTouchInputInfo, (HTOUCHINPUT, UINT, TOUCHINPUT*, int), 1) \
+    X(BOOL, CloseTouchInputHandle, (HTOUCHINPUT), 1)
+#else
+  #define __LAW_USER32_TOUCH_API(X)
+#endif
+
+#ifndef LAW_NO_PEN
+  #define __LAW_USER32_PEN_API(X) \
+    X(BOOL, GetPointerPenInfo, (UINT32, POINTER_PEN_INFO*), 0) /* Windows 8+, only for WM_POINTER* */ \
+    X(BOOL, GetPointerPenInfoHistory, (UINT32, UINT32*, POINTER_PEN_INFO*), 0)
+#else
+  #define __LAW_USER32_PEN_API(X)
+#endif
+
+#ifndef LAW_NO_FRAMEBUFFER
+  #define __LAW_USER32_FRAMEBUFFER_API(X) \
+    X(HDC, GetDC, (HWND), 1) \
+    X(int, ReleaseDC, (HWND, HDC), 1)
+  #define __LAW_GDI32_FRAMEBUFFER_API(X) \
+    X(int, StretchDIBits, (HDC, int, int, int, int, int, int, int, int, const void*, const BITMAPINFO*, UINT, DWORD), 1)
+#else
+  #define __LAW_USER32_FRAMEBUFFER_API(X)
+  #define __LAW_GDI32_FRAMEBUFFER_API(X)
+#endif
+
+#ifndef LAW_NO_CURSOR
+  #define __LAW_USER32_CURSOR_API(X) \
+    X(HCURSOR, SetCursor, (HCURSOR), 1) \
+    X(HCURSOR, LoadCursorW, (HINSTANCE, LPCWSTR), 1) \
+    X(HICON, CreateIconIndirect, (ICONINFO*), 1) \
+    X(BOOL, DestroyIcon, (HICON), 1)
+  #define __LAW_GDI32_CURSOR_API(X) \
+    X(HBITMAP, CreateBitmap, (int, int, UINT, UINT, const void*), 1) \
+    X(BOOL, DeleteObject, (HGDIOBJ), 1)
+#else
+  #define __LAW_USER32_CURSOR_API(X)
+  #define __LAW_GDI32_CURSOR_API(X)
+#endif
+
+#define __LAW_GDI32_API(X) \
+  __LAW_GDI32_FRAMEBUFFER_API(X) \
+  __LAW_GDI32_CURSOR_API(X)
+
+#define __LAW_API_POINTER(result, name, parameters, required) result (WINAPI *name) parameters;
+static struct {
+  __LAW_USER32_API(__LAW_API_POINTER)
+  __LAW_GDI32_API(__LAW_API_POINTER)
+} __law_api;
+#undef __LAW_API_POINTER
+
+static int __law_api_loaded = 0; // 1 once loaded, -1 if a library or function is missing
+
+// Load user32 and gdi32, returns 0 if they could not be loaded
+static int __law_loadApi(void) {
+  int loaded = (int)__LAW_LOAD_ACQUIRE(&__law_api_loaded);
+  if (loaded)
+    return loaded > 0;
+
+  static int lock = 0; // The threads of the displays may create their first windows at once
+  __law_spinLock(&lock);
+  loaded = __law_api_loaded;
+  if (loaded == 0) {
+    HMODULE user32 = LoadLibraryW(L"user32.dll");
+#if !defined(LAW_NO_FRAMEBUFFER) || !defined(LAW_NO_CURSOR)
+    HMODULE gdi32 = LoadLibraryW(L"gdi32.dll");
+#else
+    HMODULE gdi32 = user32; // Only the frames and cursors use gdi32
+#endif
+    loaded = user32 && gdi32 ? 1 : -1;
+
+    #define __LAW_API_LOAD(result, name, parameters, required) \
+      *(FARPROC*)&__law_api.name = GetProcAddress(module, #name); \
+      if (required && __law_api.name == NULL) loaded = -1;
+    if (loaded > 0) {
+      HMODULE module = user32;
+      __LAW_USER32_API(__LAW_API_LOAD)
+      module = gdi32;
+      __LAW_GDI32_API(__LAW_API_LOAD)
+    }
+    #undef __LAW_API_LOAD
+
+    assert(loaded > 0 && "Failed to load user32.dll and gdi32.dll");
+    __LAW_STORE_RELEASE(&__law_api_loaded, loaded);
+  }
+  __law_spinUnlock(&lock);
+  return loaded > 0;
+}
+
+// Calls of the implementation go through `__law_api` (undefined at its end)
+#define DefWindowProcW __law_api.DefWindowProcW
+#define RegisterClassW __law_api.RegisterClassW
+#define CreateWindowExW __law_api.CreateWindowExW
+#define DestroyWindow __law_api.DestroyWindow
+#define ShowWindow __law_api.ShowWindow
+#define SetWindowPos __law_api.SetWindowPos
+#define BeginDeferWindowPos __law_api.BeginDeferWindowPos
+#define DeferWindowPos __law_api.DeferWindowPos
+#define EndDeferWindowPos __law_api.EndDeferWindowPos
+#define GetClientRect __law_api.GetClientRect
+#define GetWindowRect __law_api.GetWindowRect
+#define SetWindowTextW __law_api.SetWindowTextW
+#define GetWindowTextW __law_api.GetWindowTextW
+#define ValidateRect __law_api.ValidateRect
+#define ScreenToClient __law_api.ScreenToClient
+#define GetCursorPos __law_api.GetCursorPos
+#define WindowFromPoint __law_api.WindowFromPoint
+#define GetForegroundWindow __law_api.GetForegroundWindow
+#define GetAncestor __law_api.GetAncestor
+#define GetWindowThreadProcessId __law_api.GetWindowThreadProcessId
+#define PeekMessageW __law_api.PeekMessageW
+#define GetMessageW __law_api.GetMessageW
+#define TranslateMessage __law_api.TranslateMessage
+#define DispatchMessageW __law_api.DispatchMessageW
+#define PostThreadMessageW __law_api.PostThreadMessageW
+#define PostQuitMessage __law_api.PostQuitMessage
+#define MsgWaitForMultipleObjectsEx __law_api.MsgWaitForMultipleObjectsEx
+#define GetDC __law_api.GetDC
+#define ReleaseDC __law_api.ReleaseDC
+#define EnumDisplaySettingsExW __law_api.EnumDisplaySettingsExW
+#define RegisterRawInputDevices __law_api.RegisterRawInputDevices
+#define GetRawInputData __law_api.GetRawInputData
+#define GetTouchInputInfo __law_api.GetTouchInputInfo
+#define CloseTouchInputHandle __law_api.CloseTouchInputHandle
+#define GetPointerPenInfo __law_api.GetPointerPenInfo
+#define GetPointerPenInfoHistory __law_api.GetPointerPenInfoHistory
+#ifdef _WIN64
+  #define GetWindowLongPtrW __law_api.GetWindowLongPtrW
+  #define SetWindowLongPtrW __law_api.SetWindowLongPtrW
+  #define GetClassLongPtrW __law_api.GetClassLongPtrW
+#else
+  #define GetWindowLongW __law_api.GetWindowLongW
+  #define SetWindowLongW __law_api.SetWindowLongW
+  #define GetClassLongW __law_api.GetClassLongW
+#endif
+#define StretchDIBits __law_api.StretchDIBits
+#define SetCursor __law_api.SetCursor
+#define LoadCursorW __law_api.LoadCursorW
+#define CreateIconIndirect __law_api.CreateIconIndirect
+#define DestroyIcon __law_api.DestroyIcon
+#define CreateBitmap __law_api.CreateBitmap
+#define DeleteObject __law_api.DeleteObject
+
+#else
+
+static int __law_loadApi(void) {
+  return 1; // Linked
+}
+
+#endif // LAW_LINK_USER32
+
+#pragma endregion _api
+
+#pragma region _events
+
+// Convert a performance counter value to microseconds
+static unsigned long long __law_counterToMicro(unsigned long long counter) {
+  static LARGE_INTEGER frequency = { 0 };
+  if (!frequency.QuadPart)
+    QueryPerformanceFrequency(&frequency);
+
+  unsigned long long f = (unsigned long long)frequency.QuadPart;
+  return counter / f * 1000000 + counter % f * 1000000 / f;
+}
+
+static unsigned long long __law_now(void) {
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return __law_counterToMicro((unsigned long long)counter.QuadPart);
+}
+
+static __law_State* __law_lookup(law_Window window) {
+  // Can run before any window was created, e.g. `law_getData`
+  if (!__law_loadApi())
+    return NULL;
+  return (__law_State*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
+}
+
+static ATOM __law_class_atom = 0; // Class of the windows (set by the first `law_create`)
+
+// The display is kept in the extra bytes of the window, readable by every thread
+static __law_Display* __law_displayOf(law_Window window) {
+  if (window == NULL || !__law_loadApi() || (ATOM)GetClassLongPtrW((HWND)window, GCW_ATOM) != __law_class_atom)
+    return NULL;
+  return (__law_Display*)GetWindowLongPtrW((HWND)window, 0);
+}
+
+#ifndef LAW_NO_FRAMEBUFFER
+static void __law_presentFrame(__law_State* state, const law_Frame* frame) {
+  BITMAPINFO info = { 0 };
+  info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+  info.bmiHeader.biWidth = frame->stride;
+  info.bmiHeader.biHeight = -frame->height; // Top-down rows
+  info.bmiHeader.biPlanes = 1;
+  info.bmiHeader.biBitCount = 32;
+  info.bmiHeader.biCompression = BI_RGB;
+
+  // The frame is stretched if the window was resized while it was rendered
+  RECT client;
+  GetClientRect((HWND)state->window, &client);
+  HDC dc = GetDC((HWND)state->window);
+  StretchDIBits(dc, 0, 0, client.right, client.bottom, 0, 0, frame->width, frame->height,
+    frame->pixels, &info, DIB_RGB_COLORS, SRCCOPY);
+  ReleaseDC((HWND)state->window, dc);
+}
+#endif
+
+static void __law_waitEvents(__law_Display* display) {
+  (void)display; // The messages of the thread, including the wake-up of `__law_wakeIdle`
+  MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+static void __law_wakeIdle(__law_Display* display) {
+  PostThreadMessageW((DWORD)display->thread, WM_NULL, 0, 0);
+}
+
+static void __law_sleepUntil(unsigned long long deadline) {
+  // High-resolution waitable timer (Windows 10 1803+), otherwise `Sleep` with its ~2 ms precision
+  static __LAW_THREAD_LOCAL HANDLE timer = NULL;
+  static __LAW_THREAD_LOCAL int timer_checked = 0;
+  if (!timer_checked) {
+    timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    timer_checked = 1;
+  }
+
+  unsigned long long now = __law_now();
+  if (timer) {
+    if (now >= deadline)
+      return;
+    LARGE_INTEGER due;
+    due.QuadPart = -(LONGLONG)((deadline - now) * 10); // Relative, 100 ns units
+    if (SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE))
+      WaitForSingleObject(timer, INFINITE);
+  } else if (now + 2000 < deadline) {
+    Sleep((DWORD)((deadline - now - 2000) / 1000));
+  }
+}
+
+// A connection is a thread (every thread has its own message queue),
+// the name only selects the monitor the windows are placed on
+static int __law_initDisplay(__law_Display* display) {
+  if (display->name == NULL)
+    return 1;
+  if (!__law_loadApi()) {
+    law_error = LAW_ERROR_CREATE_WINDOW;
+    return 0;
+  }
+
+  wchar_t device[CCHDEVICENAME];
+  DEVMODEW mode = { 0 };
+  mode.dmSize = sizeof(mode);
+  if (!MultiByteToWideChar(CP_UTF8, 0, display->name, -1, device, CCHDEVICENAME)
+      || !EnumDisplaySettingsExW(device, ENUM_CURRENT_SETTINGS, &mode, 0)) {
+    assert(0 && "Failed to open display"); // No such monitor
+    law_error = LAW_ERROR_CREATE_WINDOW;
+    return 0;
+  }
+
+  display->monitor = 1;
+  display->monitor_x = mode.dmPosition.x;
+  display->monitor_y = mode.dmPosition.y;
+  return 1;
+}
+
+static LRESULT CALLBACK __law_wrapperCreate(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+  // Allocating memory for the window parameters
+  __law_State* state = (__law_State*)calloc(1, sizeof(__law_State));
+  law_Data* win_data = (law_Data*)state;
+  if (win_data == NULL) {
+    assert(0 && "Failed to allocate memory for window parameters");
+    DestroyWindow((HWND)window);
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return 0;
+  }
+  // Setting the events
+  law_initEvents((law_Events*)win_data); // Initialize the events with empty functions
+  win_data->running = 1; // Window is running by default
+  win_data->user_data = NULL; // User data is NULL by default
+  state->window = (law_Window)window;
+  state->display = __law_currentDisplay(); // Created by the thread of the display
+  state->display->windows++;
+  law_getPos((law_Window)window, &state->origin_x, &state->origin_y);
+
+  // Setting the user data
+  SetWindowLongPtrW((HWND)window, GWLP_USERDATA, (LONG_PTR)win_data);
+  SetWindowLongPtrW((HWND)window, 0, (LONG_PTR)state->display); // See `__law_displayOf`
   return 0;
 }
-static LRESULT CALLBACK __law_wrapperMButtonUp(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.up)
+static LRESULT CALLBACK __law_wrapperDestroy(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+  __law_State* state = __law_lookup((law_Window)window);
+  if (state == NULL)
     return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.up((law_Window)window, win_data, LAW_MOUSE_MIDDLE);
+  // Freeing the memory
+  SetWindowLongPtrW((HWND)window, GWLP_USERDATA, 0);
+  SetWindowLongPtrW((HWND)window, 0, 0);
+  __law_destroyState(state);
   return 0;
 }
-static LRESULT CALLBACK __law_wrapperXButtonUp(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.up)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.up((law_Window)window, win_data,
-    GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? LAW_MOUSE_X1 : LAW_MOUSE_X2);
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperMouseWheel(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->mouse.wheel)
+#ifndef LAW_NO_TEXT
+static LRESULT CALLBACK __law_wrapperChar(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+  __law_State* state = __law_lookup((law_Window)window);
+  if (state == NULL || !__law_isHandled(state, LAW_EVENT_TEXT))
     return DefWindowProcW(window, uMsg, wParam, lParam);
 
-  law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-  EVENT->mouse.wheel((law_Window)window, win_data, GET_WHEEL_DELTA_WPARAM(wParam));
-  return 0;
-}
-static LRESULT CALLBACK __law_wrapperSysCommand(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  UINT command = wParam & 0xFFF0; // Masking the command to get the actual command (Windows API moment)
-  // Checking the command
-  if (command == SC_MINIMIZE) { // Call the minimize event
-    if (!EVENT->window.minimize)
-      return DefWindowProcW(window, uMsg, wParam, lParam);
-
-    law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-    EVENT->window.minimize((law_Window)window, win_data);
-    return 0;
-  } 
-  else if (command == SC_MAXIMIZE) 
-  { // Call the maximize event
-    if (!EVENT->window.maximize)
-      return DefWindowProcW(window, uMsg, wParam, lParam);
+  unsigned int code_unit = (unsigned int)wParam; // UTF-16 code unit (dead keys are already composed)
 
-    law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-    EVENT->window.maximize((law_Window)window, win_data);
+  if (code_unit >= 0xD800 && code_unit <= 0xDBFF) { // High surrogate, wait for the low one
+    state->text_surrogate = (unsigned short)code_unit;
     return 0;
   }
-  return DefWindowProcW(window, uMsg, wParam, lParam);
-}
-
-static LRESULT CALLBACK __law_wrapperShow(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  // Show or hide the window based on the wParam value
-  if (wParam) {
-    if (!EVENT->window.show)
-      return DefWindowProcW(window, uMsg, wParam, lParam);
 
-    law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-    EVENT->window.show((law_Window)window, win_data);
+  unsigned int codepoint = code_unit;
+  if (code_unit >= 0xDC00 && code_unit <= 0xDFFF) { // Low surrogate
+    if (!state->text_surrogate)
+      return 0;
+    codepoint = 0x10000 + ((state->text_surrogate - 0xD800u) << 10) + (code_unit - 0xDC00);
   }
-  else {
-    if (!EVENT->window.hide)
-      return DefWindowProcW(window, uMsg, wParam, lParam);
+  state->text_surrogate = 0;
 
-    law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-    EVENT->window.hide((law_Window)window, win_data);
+  // Control characters (backspace, enter, escape, ...) are reported by the key events only
+  if (codepoint >= 0x20 && codepoint != 0x7F) {
+    law_Event event = __law_event(LAW_EVENT_TEXT);
+    event.codepoint = codepoint;
+    law_postEvent((law_Window)window, &event);
   }
   return 0;
 }
+#endif
 
-static LRESULT CALLBACK __law_wrapperFileDrop(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.file_drop)
-    return DefWindowProcW(window, uMsg, wParam, lParam);
-
-  // TODO: Implement file drop event
-
-  return 0;
-}
+#ifndef LAW_NO_TOUCH
 static LRESULT __law_wrapperTouch(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->window.touch)
+  __law_State* state = __law_lookup((law_Window)window);
+  if (state == NULL || !__law_isHandled(state, LAW_EVENT_TOUCH))
     return DefWindowProcW(window, uMsg, wParam, lParam);
 
   UINT c_inputs = LOWORD(wParam);   // Number of touch inputs
   TOUCHINPUT touch_input[10];       // Array of touch inputs (max 10)
+  if (c_inputs > 10)
+    c_inputs = 10;
 
   if (GetTouchInputInfo((HTOUCHINPUT)lParam, c_inputs, touch_input, sizeof(TOUCHINPUT))) {
     for (UINT i = 0; i < c_inputs; i++) {
-      int id = touch_input[i].dwID;       // Identifier (ID) touch
-      int x = touch_input[i].x / 100;     // X (in pixels)
-      int y = touch_input[i].y / 100;     // Y (in pixels)
-      int dx = 0, dy = 0;                 // Delta x, y
-
-      // If the offset is supported, calculate it (no direction in TOUCHINPUT)
-      if (touch_input[i].dwMask & TOUCHEVENTF_MOVE) {
-        dx = touch_input[i].x / 100 - x; // Calculate the change in x
-        dy = touch_input[i].y / 100 - y; // Calculate the change in y
-      }
+      POINT point = { touch_input[i].x / 100, touch_input[i].y / 100 }; // in screen coordinates (pixels)
+      ScreenToClient(window, &point);
 
-      law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-      EVENT->window.touch((law_Window)window, win_data, x, y); // TODO: add id, dx, dy
+      law_Event event = __law_event(LAW_EVENT_TOUCH);
+      event.pos.x = point.x;
+      event.pos.y = point.y;
+      law_postEvent((law_Window)window, &event); // TODO: add id
     }
 
     CloseTouchInputHandle((HTOUCHINPUT)lParam);  // Free resources
   }
   return 0;
 }
+#endif
+
+#ifndef LAW_NO_PEN
+// Maximum number of coalesced pen samples read from a single WM_POINTERUPDATE
+#define __LAW_PEN_HISTORY_MAX 64
+
+// Convert the native pen info to `law_PenSample`
+static void __law_toPenSample(HWND window, const POINTER_PEN_INFO* pen_info, law_PenSample* sample) {
+  POINT point = pen_info->pointerInfo.ptPixelLocation; // in screen coordinates
+  ScreenToClient(window, &point);
+
+  sample->id = pen_info->pointerInfo.pointerId;
+  sample->x = point.x;
+  sample->y = point.y;
+  sample->pressure = pen_info->pressure; // pressure of the pen (0-1024)
+  sample->tilt_x = pen_info->tiltX;
+  sample->tilt_y = pen_info->tiltY;
+
+  // The performance counter is the time of the sample, but is not provided by every device
+  UINT64 counter = pen_info->pointerInfo.PerformanceCount;
+  sample->time = counter ? __law_counterToMicro(counter) : __law_now();
+}
 
 static LRESULT CALLBACK __law_wrapperPointerUpdate(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-  if (!EVENT->pen)
+  __law_State* state = __law_lookup((law_Window)window);
+  if (state == NULL)
     return DefWindowProcW(window, uMsg, wParam, lParam);
 
+  // Without a pen handler the samples are still recorded for the prediction,
+  // the system then synthesizes the mouse messages
+  int handled = __law_isHandled(state, LAW_EVENT_PEN);
   unsigned int pointer_id = GET_POINTERID_WPARAM(wParam);
   POINTER_PEN_INFO pen_info;
 
   if (GetPointerPenInfo(pointer_id, &pen_info)) {
-    int pressure = pen_info.pressure; // pressure of the pen (0-1024)
+    // The system coalesces the samples of high-rate pens into one message,
+    // the history contains all of them (newest first)
+    POINTER_PEN_INFO history[__LAW_PEN_HISTORY_MAX];
+    UINT32 count = pen_info.pointerInfo.historyCount;
+    if (count > __LAW_PEN_HISTORY_MAX)
+      count = __LAW_PEN_HISTORY_MAX;
+
+    if (count <= 1 || !GetPointerPenInfoHistory(pointer_id, &count, history)) {
+      history[0] = pen_info;
+      count = 1;
+    }
+
+    // The older samples only go to `pen_batch` and the prediction
+    law_PenSample sample;
+    for (UINT32 i = count; i-- > 1;) { // oldest first
+      __law_toPenSample(window, &history[i], &sample);
+      if (state->data.event.pen_batch)
+        __law_pushPenSample(state, &sample);
+      __law_recordPointer(state, sample.x, sample.y, sample.time, __LAW_POINTER_PEN);
+    }
+
+    // The latest sample is the event
+    __law_toPenSample(window, &history[0], &sample);
+    if (!handled) {
+      __law_recordPointer(state, sample.x, sample.y, sample.time, __LAW_POINTER_PEN);
+      return DefWindowProcW(window, uMsg, wParam, lParam);
+    }
+    law_Event event = __law_event(LAW_EVENT_PEN);
+    event.time = sample.time;
+    event.pen.id = sample.id;
+    event.pen.x = sample.x;
+    event.pen.y = sample.y;
+    event.pen.pressure = sample.pressure;
+    event.pen.tilt_x = sample.tilt_x;
+    event.pen.tilt_y = sample.tilt_y;
+    law_postEvent((law_Window)window, &event);
+  }
+  return handled ? 0 : DefWindowProcW(window, uMsg, wParam, lParam);
+}
+#endif
+
+#ifndef LAW_NO_CURSOR
+static LRESULT CALLBACK __law_wrapperSetCursor(HWND window, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+  __law_State* state = __law_lookup((law_Window)window);
+  if (state == NULL || state->cursor == NULL || LOWORD(lParam) != HTCLIENT) // The borders keep the resize cursors
+    return DefWindowProcW(window, uMsg, wParam, lParam);
+
+  SetCursor((HCURSOR)state->cursor);
+  return TRUE;
+}
+#endif
+
+#pragma region _input_thread
+
+static HANDLE __law_input_thread = NULL;
+static DWORD __law_input_thread_id = 0;
+static DWORD __law_input_owner = 0;   // Thread reading its input on the input thread
+static int __law_input_running = 0;   // Non-zero if the keyboard and mouse are read by the input thread
+#ifndef LAW_NO_MOUSE
+static HWND __law_input_capture = NULL; // Window receiving the mouse while a button is held
+static unsigned int __law_input_buttons = 0; // Mouse buttons held
+#endif
+
+// The window if it's a window of the library, NULL otherwise
+static HWND __law_inputTarget(HWND window) {
+  window = window ? GetAncestor(window, GA_ROOT) : NULL;
+  if (window == NULL || (ATOM)GetClassLongPtrW(window, GCW_ATOM) != __law_class_atom)
+    return NULL;
+
+  // Only the windows of the thread that started the input thread
+  return GetWindowThreadProcessId(window, NULL) == __law_input_owner ? window : NULL;
+}
+
+static void __law_readRawInput(HRAWINPUT handle) {
+  RAWINPUT raw;
+  UINT size = sizeof(raw);
+  if (GetRawInputData(handle, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) == (UINT)-1)
+    return;
+
+  law_Event event = __law_event(LAW_EVENT_NONE);
+  event.time = __law_now(); // Time of arrival
+
+  if (raw.header.dwType == RIM_TYPEKEYBOARD) {
+    const RAWKEYBOARD* keyboard = &raw.data.keyboard;
+    HWND window = __law_inputTarget(GetForegroundWindow());
+    if (window == NULL || keyboard->VKey == 0xFF) // 0xFF is a fake key of an escape sequence
+      return;
+
+    int extended = (keyboard->Flags & RI_KEY_E0) != 0 || keyboard->MakeCode == 0x36; // 0x36 is the right shift key
+    event.type = keyboard->Flags & RI_KEY_BREAK ? LAW_EVENT_KEY_UP : LAW_EVENT_KEY_DOWN;
+    event.key = law_keyFromVk(keyboard->VKey, extended);
+    law_postEventFromThread((law_Window)window, &event);
+    return;
+  }
+
+#ifndef LAW_NO_MOUSE
+  if (raw.header.dwType != RIM_TYPEMOUSE)
+    return;
+
+  const RAWMOUSE* mouse = &raw.data.mouse;
+  POINT point;
+  GetCursorPos(&point);
+  HWND window = __law_input_capture ? __law_input_capture : __law_inputTarget(WindowFromPoint(point));
+  if (window == NULL)
+    return;
+
+  if (mouse->lLastX || mouse->lLastY || (mouse->usFlags & MOUSE_MOVE_ABSOLUTE)) {
+    ScreenToClient(window, &point);
+    event.type = LAW_EVENT_MOUSE_MOVE;
+    event.pos.x = point.x;
+    event.pos.y = point.y;
+    law_postEventFromThread((law_Window)window, &event);
+  }
+
+  static const struct { USHORT flag; int type; int button; } buttons[] = {
+    { RI_MOUSE_LEFT_BUTTON_DOWN, LAW_EVENT_MOUSE_DOWN, LAW_MOUSE_LEFT },
+    { RI_MOUSE_LEFT_BUTTON_UP, LAW_EVENT_MOUSE_UP, LAW_MOUSE_LEFT },
+    { RI_MOUSE_RIGHT_BUTTON_DOWN, LAW_EVENT_MOUSE_DOWN, LAW_MOUSE_RIGHT },
+    { RI_MOUSE_RIGHT_BUTTON_UP, LAW_EVENT_MOUSE_UP, LAW_MOUSE_RIGHT },
+    { RI_MOUSE_MIDDLE_BUTTON_DOWN, LAW_EVENT_MOUSE_DOWN, LAW_MOUSE_MIDDLE },
+    { RI_MOUSE_MIDDLE_BUTTON_UP, LAW_EVENT_MOUSE_UP, LAW_MOUSE_MIDDLE },
+    { RI_MOUSE_BUTTON_4_DOWN, LAW_EVENT_MOUSE_DOWN, LAW_MOUSE_X1 },
+    { RI_MOUSE_BUTTON_4_UP, LAW_EVENT_MOUSE_UP, LAW_MOUSE_X1 },
+    { RI_MOUSE_BUTTON_5_DOWN, LAW_EVENT_MOUSE_DOWN, LAW_MOUSE_X2 },
+    { RI_MOUSE_BUTTON_5_UP, LAW_EVENT_MOUSE_UP, LAW_MOUSE_X2 },
+  };
+  for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+    if (!(mouse->usButtonFlags & buttons[i].flag))
+      continue;
+
+    // Like the mouse capture, the window keeps the mouse while a button is held
+    if (buttons[i].type == LAW_EVENT_MOUSE_DOWN)
+      __law_input_buttons |= 1u << buttons[i].button;
+    else
+      __law_input_buttons &= ~(1u << buttons[i].button);
+    __law_input_capture = __law_input_buttons ? window : NULL;
+
+    event.type = buttons[i].type;
+    event.button = buttons[i].button;
+    law_postEventFromThread((law_Window)window, &event);
+  }
+
+  if (mouse->usButtonFlags & RI_MOUSE_WHEEL) {
+    event.type = LAW_EVENT_MOUSE_WHEEL;
+    event.wheel = (short)mouse->usButtonData;
+    law_postEventFromThread((law_Window)window, &event);
+  }
+#endif
+}
+
+static LRESULT CALLBACK __law_inputProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+  if (uMsg == WM_INPUT)
+    __law_readRawInput((HRAWINPUT)lParam);
+  return DefWindowProcW(hwnd, uMsg, wParam, lParam); // Frees the raw input
+}
+
+static DWORD WINAPI __law_inputThreadMain(LPVOID ready) {
+  WNDCLASSW wc = { 0 };
+  wc.lpfnWndProc = __law_inputProc;
+  wc.hInstance = GetModuleHandleW(NULL);
+  wc.lpszClassName = L"la_window_input";
+  RegisterClassW(&wc);
+
+  // Message-only window receiving the raw input of the whole process
+  HWND sink = CreateWindowExW(0, wc.lpszClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, wc.hInstance, NULL);
+  RAWINPUTDEVICE devices[] = {
+    { 0x01, 0x06, RIDEV_INPUTSINK, sink }, // Keyboard
+#ifndef LAW_NO_MOUSE
+    { 0x01, 0x02, RIDEV_INPUTSINK, sink }, // Mouse
+#endif
+  };
+  UINT count = sizeof(devices) / sizeof(devices[0]);
+  __law_input_running = sink && RegisterRawInputDevices(devices, count, sizeof(RAWINPUTDEVICE));
+  SetEvent((HANDLE)ready);
 
-    // Tilt of the pen
-    int tilt_x = pen_info.tiltX;
-    int tilt_y = pen_info.tiltY;
+  MSG msg;
+  while (__law_input_running && GetMessageW(&msg, NULL, 0, 0) > 0) // Until WM_QUIT
+    DispatchMessageW(&msg);
 
-    law_Data* win_data = (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
-    EVENT->pen((law_Window)window, win_data, pointer_id, pressure, tilt_x, tilt_y);
+  for (UINT i = 0; i < count; i++) {
+    devices[i].dwFlags = RIDEV_REMOVE;
+    devices[i].hwndTarget = NULL;
   }
+  RegisterRawInputDevices(devices, count, sizeof(RAWINPUTDEVICE));
+  if (sink)
+    DestroyWindow(sink);
   return 0;
 }
 
-#undef EVENT // Remove the EVENT macro
+int law_startInputThread(void) {
+  if (__law_input_thread)
+    return __law_input_running;
+  if (!__law_loadApi())
+    return 0;
+
+  HANDLE ready = CreateEventW(NULL, TRUE, FALSE, NULL);
+  if (ready == NULL)
+    return 0;
+
+  __law_input_owner = GetCurrentThreadId();
+  __law_input_thread = CreateThread(NULL, 0, __law_inputThreadMain, ready, 0, &__law_input_thread_id);
+  if (__law_input_thread)
+    WaitForSingleObject(ready, INFINITE);
+  CloseHandle(ready);
+
+  if (__law_input_thread && !__law_input_running) { // Raw input not available
+    WaitForSingleObject(__law_input_thread, INFINITE);
+    CloseHandle(__law_input_thread);
+    __law_input_thread = NULL;
+  }
+  return __law_input_running;
+}
+
+void law_stopInputThread(void) {
+  if (__law_input_thread == NULL)
+    return;
 
+  PostThreadMessageW(__law_input_thread_id, WM_QUIT, 0, 0);
+  WaitForSingleObject(__law_input_thread, INFINITE);
+  CloseHandle(__law_input_thread);
+  __law_input_thread = NULL;
+  __law_input_running = 0;
+}
+
+// Non-zero if the message is read by the input thread
+static int __law_isThreadInput(UINT uMsg) {
+  return __law_input_running && ((uMsg >= WM_KEYDOWN && uMsg <= WM_KEYUP)
+    || (uMsg >= WM_MOUSEMOVE && uMsg <= WM_XBUTTONUP)) && GetCurrentThreadId() == __law_input_owner;
+}
+
+#pragma endregion _input_thread
 
+// Translate the key of WM_KEYDOWN / WM_KEYUP to `LAW_KEY_*`
+static int __law_translateKey(WPARAM wParam, LPARAM lParam) {
+  unsigned int scan_code = (lParam >> 16) & 0xFF;
+  int extended = (lParam >> 24) & 1 || scan_code == 0x36; // 0x36 is the right shift key
+  return law_keyFromVk((unsigned int)wParam, extended);
+}
+
+// Translate the native message to `law_Event`, returns 0 if the message is not an event
+static int __law_translate(UINT uMsg, WPARAM wParam, LPARAM lParam, law_Event* event) {
+  event->time = 0; // Time of arrival
+
+  switch (uMsg) {
+  case WM_CLOSE: event->type = LAW_EVENT_CLOSE; return 1;
+  case WM_SETFOCUS: event->type = LAW_EVENT_FOCUS; return 1;
+  case WM_KILLFOCUS: event->type = LAW_EVENT_UNFOCUS; return 1;
+  case WM_PAINT: event->type = LAW_EVENT_REDRAW; return 1;
+  case WM_SHOWWINDOW: event->type = wParam ? LAW_EVENT_SHOW : LAW_EVENT_HIDE; return 1;
+  case WM_SIZE:
+    event->type = LAW_EVENT_RESIZE;
+    event->size.width = LOWORD(lParam);
+    event->size.height = HIWORD(lParam);
+    return 1;
+  case WM_MOVE:
+    event->type = LAW_EVENT_MOVE;
+    event->pos.x = (short)LOWORD(lParam);
+    event->pos.y = (short)HIWORD(lParam);
+    return 1;
+  case WM_SYSCOMMAND:
+    // Masking the command to get the actual command (Windows API moment)
+    switch (wParam & 0xFFF0) {
+    case SC_MINIMIZE: event->type = LAW_EVENT_MINIMIZE; return 1;
+    case SC_MAXIMIZE: event->type = LAW_EVENT_MAXIMIZE; return 1;
+    default: return 0;
+    }
+  case WM_KEYDOWN:
+  case WM_KEYUP:
+    event->type = uMsg == WM_KEYDOWN ? LAW_EVENT_KEY_DOWN : LAW_EVENT_KEY_UP;
+    event->key = __law_translateKey(wParam, lParam);
+    return 1;
+#ifndef LAW_NO_MOUSE
+  case WM_MOUSEMOVE:
+    event->type = LAW_EVENT_MOUSE_MOVE;
+    event->pos.x = (short)LOWORD(lParam);
+    event->pos.y = (short)HIWORD(lParam);
+    return 1;
+  case WM_LBUTTONDOWN: event->type = LAW_EVENT_MOUSE_DOWN; event->button = LAW_MOUSE_LEFT; return 1;
+  case WM_RBUTTONDOWN: event->type = LAW_EVENT_MOUSE_DOWN; event->button = LAW_MOUSE_RIGHT; return 1;
+  case WM_MBUTTONDOWN: event->type = LAW_EVENT_MOUSE_DOWN; event->button = LAW_MOUSE_MIDDLE; return 1;
+  case WM_LBUTTONUP: event->type = LAW_EVENT_MOUSE_UP; event->button = LAW_MOUSE_LEFT; return 1;
+  case WM_RBUTTONUP: event->type = LAW_EVENT_MOUSE_UP; event->button = LAW_MOUSE_RIGHT; return 1;
+  case WM_MBUTTONUP: event->type = LAW_EVENT_MOUSE_UP; event->button = LAW_MOUSE_MIDDLE; return 1;
+  case WM_XBUTTONDOWN:
+  case WM_XBUTTONUP:
+    event->type = uMsg == WM_XBUTTONDOWN ? LAW_EVENT_MOUSE_DOWN : LAW_EVENT_MOUSE_UP;
+    event->button = GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? LAW_MOUSE_X1 : LAW_MOUSE_X2;
+    return 1;
+  case WM_MOUSEWHEEL:
+    event->type = LAW_EVENT_MOUSE_WHEEL;
+    event->wheel = GET_WHEEL_DELTA_WPARAM(wParam);
+    return 1;
+#endif
+  default:
+    return 0;
+  }
+}
 
 static LRESULT CALLBACK __law_proc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
   switch (uMsg) {
-  case WM_MOUSEMOVE: return __law_wrapperMouseMove(hwnd, uMsg, wParam, lParam);
-  case WM_SIZE: return __law_wrapperResize(hwnd, uMsg, wParam, lParam);
-  case WM_MOVE: return __law_wrapperMove(hwnd, uMsg, wParam, lParam);
-  case WM_PAINT: return __law_wrapperRedraw(hwnd, uMsg, wParam, lParam);
-  case WM_KEYDOWN: return __law_wrapperKeyDown(hwnd, uMsg, wParam, lParam);
-  case WM_KEYUP: return __law_wrapperKeyUp(hwnd, uMsg, wParam, lParam);
-  case WM_LBUTTONDOWN: return __law_wrapperLButtonDown(hwnd, uMsg, wParam, lParam);
-  case WM_RBUTTONDOWN: return __law_wrapperRButtonDown(hwnd, uMsg, wParam, lParam);
-  case WM_MBUTTONDOWN: return __law_wrapperMButtonDown(hwnd, uMsg, wParam, lParam);
-  case WM_XBUTTONDOWN: return __law_wrapperXButtonDown(hwnd, uMsg, wParam, lParam);
-  case WM_LBUTTONUP: return __law_wrapperLButtonUp(hwnd, uMsg, wParam, lParam);
-  case WM_RBUTTONUP: return __law_wrapperRButtonUp(hwnd, uMsg, wParam, lParam);
-  case WM_MBUTTONUP: return __law_wrapperMButtonUp(hwnd, uMsg, wParam, lParam);
-  case WM_XBUTTONUP: return __law_wrapperXButtonUp(hwnd, uMsg, wParam, lParam);
-  case WM_MOUSEWHEEL: return __law_wrapperMouseWheel(hwnd, uMsg, wParam, lParam);
-  case WM_SYSCOMMAND: return __law_wrapperSysCommand(hwnd, uMsg, wParam, lParam);
-  case WM_SHOWWINDOW: return __law_wrapperShow(hwnd, uMsg, wParam, lParam);
-  case WM_TOUCH: return __law_wrapperTouch(hwnd, uMsg, wParam, lParam);
-  case WM_POINTERUPDATE: return __law_wrapperPointerUpdate(hwnd, uMsg, wParam, lParam);
-  case WM_SETFOCUS: return __law_wrapperFocus(hwnd, uMsg, wParam, lParam);
-  case WM_KILLFOCUS: return __law_wrapperUnfocus(hwnd, uMsg, wParam, lParam);
-  case WM_DROPFILES: return __law_wrapperFileDrop(hwnd, uMsg, wParam, lParam);
-  case WM_CLOSE: return __law_wrapperClose(hwnd, uMsg, wParam, lParam);
   case WM_CREATE: return __law_wrapperCreate(hwnd, uMsg, wParam, lParam);
   case WM_DESTROY: return __law_wrapperDestroy(hwnd, uMsg, wParam, lParam);
-  default: return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+#ifndef LAW_NO_TEXT
+  case WM_CHAR: return __law_wrapperChar(hwnd, uMsg, wParam, lParam);
+#endif
+#ifndef LAW_NO_TOUCH
+  case WM_TOUCH: return __law_wrapperTouch(hwnd, uMsg, wParam, lParam);
+#endif
+#ifndef LAW_NO_PEN
+  case WM_POINTERUPDATE: return __law_wrapperPointerUpdate(hwnd, uMsg, wParam, lParam);
+#endif
+#ifndef LAW_NO_CURSOR
+  case WM_SETCURSOR: return __law_wrapperSetCursor(hwnd, uMsg, wParam, lParam);
+#endif
+  }
+
+  // Everything else goes through the shared event core,
+  // messages without a handler get the default processing
+  law_Event event;
+  if (!__law_isThreadInput(uMsg) && __law_translate(uMsg, wParam, lParam, &event) && law_postEvent((law_Window)hwnd, &event)) {
+    if (uMsg == WM_PAINT) // The contents are drawn by the `redraw` handler during `law_update`
+      ValidateRect(hwnd, NULL);
+    return 0;
   }
+  return DefWindowProcW(hwnd, uMsg, wParam, lParam);
 }
 
 void law_update(law_Window window) {
+  __law_Display* display = __law_currentDisplay();
+  display->thread = GetCurrentThreadId(); // Before the waiting flag is set
+  __law_idleWait(display);
   MSG msg;
-  while (PeekMessageW(&msg, (HWND)window, 0, 0, PM_REMOVE)) {
+  while (__law_loadApi() && !__law_isOverBudget(display) && PeekMessageW(&msg, (HWND)window, 0, 0, PM_REMOVE)) {
     if (msg.message == WM_QUIT) {
-      if (__law_exit_func)
-        __law_exit_func((int)msg.wParam);
+      __law_quit(display, (int)msg.wParam);
       break;
     }
     TranslateMessage(&msg);
     DispatchMessageW(&msg);
   }
+
+  // Deliver the events batched during the update
+  __law_flushPending(window);
 }
 
 void law_exit(int exit_code) {
-  PostQuitMessage(exit_code);
+  if (__law_loadApi())
+    PostQuitMessage(exit_code);
 }
 
 
@@ -773,22 +4095,38 @@ void law_exit(int exit_code) {
 #endif // LA_DEFAULT_WINDOW_CLASS
 
 law_Window law_create(int width, int height, const wchar_t* title, law_Window parent) {
+  if (!__law_loadApi()) {
+    law_error = LAW_ERROR_CREATE_WINDOW;
+    return NULL;
+  }
+
   static unsigned char class_registered = 0;
+  static int class_lock = 0; // The threads of the displays create windows at the same time
+  __law_spinLock(&class_lock);
   if (!class_registered) {
     // Window class
     WNDCLASSW wc = { 0 };
     wc.lpfnWndProc = __law_proc;
+    wc.cbWndExtra = sizeof(LONG_PTR); // Display of the window
     wc.hInstance = GetModuleHandleW(NULL);
     wc.lpszClassName = LA_DEFAULT_WINDOW_CLASS;
 
     // Registering the window class
-    if (RegisterClassW(&wc) == 0) {
+    __law_class_atom = RegisterClassW(&wc);
+    if (__law_class_atom == 0) {
+      __law_spinUnlock(&class_lock);
       assert(0 && "Failed to register window class");
       law_error = LAW_ERROR_CREATE_WINDOW;
       return NULL;
     }
     class_registered = 1;
   }
+  __law_spinUnlock(&class_lock);
+
+  // Windows of an opened display are placed on its monitor
+  __law_Display* display = __law_currentDisplay();
+  int x = display->monitor ? display->monitor_x : CW_USEDEFAULT;
+  int y = display->monitor ? display->monitor_y : CW_USEDEFAULT;
 
   // Creating a window
   HWND hwnd = CreateWindowExW(
@@ -796,7 +4134,7 @@ law_Window law_create(int width, int height, const wchar_t* title, law_Window pa
     LA_DEFAULT_WINDOW_CLASS,           // Window class
     title,                             // Window title
     WS_OVERLAPPEDWINDOW & ~WS_VISIBLE, // Window style
-    CW_USEDEFAULT, CW_USEDEFAULT,      // Position of the window
+    x, y,                              // Position of the window
     width, height,                     // Size of the window
     (HWND)parent,                      // Parent window
     NULL,                              // Menu
@@ -817,6 +4155,8 @@ void law_destroy(law_Window window) {
 }
 
 void law_setTitle(law_Window window, const wchar_t* title) {
+  if (__law_recordTitle(window, title))
+    return;
   SetWindowTextW((HWND)window, title);
 }
 
@@ -827,10 +4167,14 @@ const wchar_t* law_getTitle(law_Window window) {
 }
 
 void law_setSize(law_Window window, int width, int height) {
+  if (__law_recordSize(window, width, height))
+    return;
   SetWindowPos((HWND)window, HWND_TOP, 0, 0, width, height, SWP_NOMOVE);
 }
 
 void law_setPos(law_Window window, int x, int y) {
+  if (__law_recordPos(window, x, y))
+    return;
   SetWindowPos((HWND)window, HWND_TOP, x, y, 0, 0, SWP_NOSIZE);
 }
 
@@ -864,17 +4208,474 @@ void law_maximize(law_Window window) {
   ShowWindow((HWND)window, SW_MAXIMIZE);
 }
 
-law_Data* law_getData(law_Window window) {
-  return (law_Data*)GetWindowLongPtrW((HWND)window, GWLP_USERDATA);
+static void __law_showMany(const law_Window* windows, size_t count) {
+  // One repaint of the screen for all windows
+  HDWP positions = BeginDeferWindowPos((int)count);
+  for (size_t i = 0; i < count && positions; i++)
+    positions = DeferWindowPos(positions, (HWND)windows[i], NULL, 0, 0, 0, 0,
+      SWP_SHOWWINDOW | SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+  if (positions == NULL || !EndDeferWindowPos(positions)) { // Shown one by one
+    for (size_t i = 0; i < count; i++)
+      ShowWindow((HWND)windows[i], SW_SHOW);
+    return;
+  }
+
+  // SWP_SHOWWINDOW does not send WM_SHOWWINDOW
+  for (size_t i = 0; i < count; i++) {
+    law_Event event = __law_event(LAW_EVENT_SHOW);
+    law_postEvent(windows[i], &event);
+  }
+}
+
+static void __law_applyChanges(__law_State* state, const __law_Transaction* transaction) {
+  HWND window = (HWND)state->window;
+  if (transaction->changes & (__LAW_CHANGE_POS | __LAW_CHANGE_SIZE)) { // One WM_MOVE and WM_SIZE
+    UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+    if (!(transaction->changes & __LAW_CHANGE_POS))
+      flags |= SWP_NOMOVE;
+    if (!(transaction->changes & __LAW_CHANGE_SIZE))
+      flags |= SWP_NOSIZE;
+    SetWindowPos(window, NULL, transaction->x, transaction->y, transaction->width, transaction->height, flags);
+  }
+  if (transaction->changes & __LAW_CHANGE_TITLE)
+    SetWindowTextW(window, transaction->title);
 }
 
 #pragma endregion _window
 
+#pragma region _cursors
+#ifndef LAW_NO_CURSOR
+
+law_Cursor law_createCursor(const unsigned int* pixels, int width, int height, int hot_x, int hot_y) {
+  if (pixels == NULL || width <= 0 || height <= 0 || !__law_loadApi())
+    return NULL;
+
+  // 0xAARRGGBB is BGRA in memory, the layout of a 32-bit bitmap,
+  // the alpha channel replaces the mask
+  HBITMAP color = CreateBitmap(width, height, 1, 32, pixels);
+  HBITMAP mask = CreateBitmap(width, height, 1, 1, NULL);
+  ICONINFO info = { FALSE, (DWORD)hot_x, (DWORD)hot_y, mask, color };
+  HCURSOR cursor = color && mask ? (HCURSOR)CreateIconIndirect(&info) : NULL;
+  if (color)
+    DeleteObject(color); // Copied by the cursor
+  if (mask)
+    DeleteObject(mask);
+
+  assert(cursor && "Failed to create cursor");
+  return (law_Cursor)cursor;
+}
+
+void law_destroyCursor(law_Cursor cursor) {
+  if (cursor)
+    DestroyIcon((HICON)cursor);
+}
+
+void law_setCursor(law_Window window, law_Cursor cursor) {
+  __law_State* state = __law_lookup(window);
+  if (state == NULL || state->cursor == cursor)
+    return;
+  state->cursor = cursor;
+
+  // Switched now if the pointer is over the window, otherwise by the next WM_SETCURSOR
+  POINT point;
+  if (GetCursorPos(&point) && WindowFromPoint(point) == (HWND)window)
+    SetCursor(cursor ? (HCURSOR)cursor : LoadCursorW(NULL, IDC_ARROW));
+}
+
+#endif // LAW_NO_CURSOR
+#pragma endregion _cursors
+
+#ifndef LAW_LINK_USER32 // The names are the system's again for the code including this header
+  #undef DefWindowProcW
+  #undef RegisterClassW
+  #undef CreateWindowExW
+  #undef DestroyWindow
+  #undef ShowWindow
+  #undef SetWindowPos
+  #undef BeginDeferWindowPos
+  #undef DeferWindowPos
+  #undef EndDeferWindowPos
+  #undef GetClientRect
+  #undef GetWindowRect
+  #undef SetWindowTextW
+  #undef GetWindowTextW
+  #undef ValidateRect
+  #undef ScreenToClient
+  #undef GetCursorPos
+  #undef WindowFromPoint
+  #undef GetForegroundWindow
+  #undef GetAncestor
+  #undef GetWindowThreadProcessId
+  #undef PeekMessageW
+  #undef GetMessageW
+  #undef TranslateMessage
+  #undef DispatchMessageW
+  #undef PostThreadMessageW
+  #undef PostQuitMessage
+  #undef MsgWaitForMultipleObjectsEx
+  #undef GetDC
+  #undef ReleaseDC
+  #undef EnumDisplaySettingsExW
+  #undef RegisterRawInputDevices
+  #undef GetRawInputData
+  #undef GetTouchInputInfo
+  #undef CloseTouchInputHandle
+  #undef GetPointerPenInfo
+  #undef GetPointerPenInfoHistory
+  #ifdef _WIN64
+    #undef GetWindowLongPtrW
+    #undef SetWindowLongPtrW
+    #undef GetClassLongPtrW
+  #else
+    #undef GetWindowLongW
+    #undef SetWindowLongW
+    #undef GetClassLongW
+  #endif
+  #undef StretchDIBits
+  #undef SetCursor
+  #undef LoadCursorW
+  #undef CreateIconIndirect
+  #undef DestroyIcon
+  #undef CreateBitmap
+  #undef DeleteObject
+#endif // LAW_LINK_USER32
+
 #endif // LA_WINDOW_IMPLEMENTATION
 #endif // _WIN32
 #pragma endregion win32
 
 
+// ------------------- Headless Implementation -------------------
+#pragma region headless
+#ifdef LAW_HEADLESS // Windows exist in memory only, define 'LAW_HEADLESS' to use it on any platform
+
+// Define 'LA_WINDOW_IMPLEMENTATION' in your source file 
+// before including this header to create the implementation.
+#ifdef LA_WINDOW_IMPLEMENTATION
+#include <string.h> // For memcpy
+#include <time.h>   // For clock_gettime, clock_nanosleep
+#include <errno.h>  // For EINTR
+#include <wchar.h>  // For wcslen
+
+/*
+  The headless backend has no display: the windows are plain memory, 
+  and the only input is `law_postEvent`. Like X11 windows, a headless
+  window is a numeric ID that is looked up in the registry on every call.
+  It's used for tests and benchmarks of the platform-independent code.
+*/
+
+typedef struct {
+  __law_State state; // Internal state (must be the first member)
+  wchar_t* title;    // Title of the window
+  int x, y;          // Position of the window
+  int width, height; // Size of the window
+  int visible;       // Non-zero if the window is shown
+} __law_HeadlessWindow;
+
+// IDs are never reused, and unique across the displays (the live windows
+// are in the registry of their display)
+static unsigned int __law_headless_next_id = 1;
+
+static unsigned long long __law_now(void) {
+  struct timespec now;
+#ifdef CLOCK_MONOTONIC
+  clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+  timespec_get(&now, TIME_UTC);
+#endif
+  return (unsigned long long)now.tv_sec * 1000000 + (unsigned long long)now.tv_nsec / 1000;
+}
+
+static __law_State* __law_lookup(law_Window window) {
+  return __law_registryFind(&__law_currentDisplay()->registry, (size_t)window);
+}
+
+// Live windows of all displays, for the other threads (see `__law_displayOf`)
+static __law_Registry __law_headless_windows;
+static int __law_headless_windows_lock = 0;
+
+static __law_Display* __law_displayOf(law_Window window) {
+  __law_spinLock(&__law_headless_windows_lock);
+  __law_State* state = __law_registryFind(&__law_headless_windows, (size_t)window);
+  __law_Display* display = state ? state->display : NULL;
+  __law_spinUnlock(&__law_headless_windows_lock);
+  return display;
+}
+
+static int __law_initDisplay(__law_Display* display) {
+  (void)display;
+  return 1; // Nothing to connect to
+}
+
+#ifndef LAW_NO_FRAMEBUFFER
+static void __law_presentFrame(__law_State* state, const law_Frame* frame) {
+  (void)state; // Nothing to show the frame on
+  (void)frame;
+}
+#endif
+
+static __law_Mutex __law_headless_idle_mutex = __LAW_MUTEX_INITIALIZER;
+static __law_Cond __law_headless_idle_cond = __LAW_COND_INITIALIZER;
+
+static void __law_waitEvents(__law_Display* display) {
+  __law_mutexLock(&__law_headless_idle_mutex);
+  while (!__law_inputPending(display))
+    __law_condWait(&__law_headless_idle_cond, &__law_headless_idle_mutex);
+  __law_mutexUnlock(&__law_headless_idle_mutex);
+}
+
+static void __law_wakeIdle(__law_Display* display) {
+  (void)display; // Shared by the displays, each waiting thread checks its own ring
+  __law_mutexLock(&__law_headless_idle_mutex);
+  __law_condBroadcast(&__law_headless_idle_cond);
+  __law_mutexUnlock(&__law_headless_idle_mutex);
+}
+
+static void __law_sleepUntil(unsigned long long deadline) {
+#ifdef CLOCK_MONOTONIC // Absolute sleep on the clock of `__law_now`, no drift
+  struct timespec until = { (time_t)(deadline / 1000000), (long)(deadline % 1000000) * 1000 };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) {}
+#else
+  unsigned long long now = __law_now();
+  if (now < deadline) {
+    struct timespec duration = { (time_t)((deadline - now) / 1000000), (long)((deadline - now) % 1000000) * 1000 };
+    nanosleep(&duration, NULL);
+  }
+#endif
+}
+
+#pragma region _events
+
+// Post an event generated by a window function (like a window manager would)
+static void __law_headlessNotify(law_Window window, int type, int a, int b) {
+  law_Event event = __law_event(type);
+  event.pos.x = a;
+  event.pos.y = b;
+  law_postEvent(window, &event);
+}
+
+void law_update(law_Window window) {
+  __law_Display* display = __law_currentDisplay();
+  __law_idleWait(display);
+  if (display->quit) {
+    display->quit = 0;
+    __law_quit(display, display->quit_code);
+  }
+
+  __law_flushPending(window);
+}
+
+void law_exit(int exit_code) {
+  __law_Display* display = __law_currentDisplay();
+  display->quit = 1;
+  display->quit_code = exit_code;
+}
+
+int law_startInputThread(void) {
+  return 0; // No input devices, the input comes from `law_postEventFromThread`
+}
+
+void law_stopInputThread(void) {
+}
+
+#pragma endregion _events
+
+#pragma region _window
+
+law_Window law_create(int width, int height, const wchar_t* title, law_Window parent) {
+  (void)parent; // No window hierarchy
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)calloc(1, sizeof(__law_HeadlessWindow));
+  if (win == NULL) {
+    assert(0 && "Failed to allocate memory for window parameters");
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return NULL;
+  }
+
+  law_initEvents(&win->state.data.event);
+  win->state.data.running = 1; // Window is running by default
+  win->state.data.user_data = NULL;
+  win->state.window = (law_Window)(size_t)__LAW_FETCH_ADD(&__law_headless_next_id, 1);
+  win->state.display = __law_currentDisplay();
+  win->width = width;
+  win->height = height;
+
+  if (!__law_registryInsert(&win->state.display->registry, (size_t)win->state.window, &win->state)) {
+    assert(0 && "Failed to create window");
+    law_error = LAW_ERROR_CREATE_WINDOW;
+    free(win);
+    return NULL;
+  }
+  __law_spinLock(&__law_headless_windows_lock);
+  int inserted = __law_registryInsert(&__law_headless_windows, (size_t)win->state.window, &win->state);
+  __law_spinUnlock(&__law_headless_windows_lock);
+  if (!inserted) {
+    assert(0 && "Failed to create window");
+    law_error = LAW_ERROR_CREATE_WINDOW;
+    __law_registryRemove(&win->state.display->registry, (size_t)win->state.window);
+    free(win);
+    return NULL;
+  }
+  win->state.display->windows++;
+
+  law_setTitle(win->state.window, title);
+  return win->state.window;
+}
+
+void law_destroy(law_Window window) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL)
+    return;
+
+  __law_registryRemove(&win->state.display->registry, (size_t)window);
+  __law_spinLock(&__law_headless_windows_lock);
+  __law_registryRemove(&__law_headless_windows, (size_t)window);
+  __law_spinUnlock(&__law_headless_windows_lock);
+  free(win->title);
+  win->title = NULL;
+  __law_destroyState(&win->state);
+}
+
+void law_setTitle(law_Window window, const wchar_t* title) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL || __law_recordTitle(window, title))
+    return;
+
+  size_t length = title ? wcslen(title) : 0;
+  wchar_t* copy = (wchar_t*)malloc((length + 1) * sizeof(wchar_t));
+  if (copy == NULL)
+    return;
+  if (length)
+    memcpy(copy, title, length * sizeof(wchar_t));
+  copy[length] = L'\0';
+
+  free(win->title);
+  win->title = copy;
+}
+
+const wchar_t* law_getTitle(law_Window window) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  return win ? win->title : L"";
+}
+
+void law_setSize(law_Window window, int width, int height) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL || __law_recordSize(window, width, height) || (win->width == width && win->height == height))
+    return;
+
+  win->width = width;
+  win->height = height;
+  __law_headlessNotify(window, LAW_EVENT_RESIZE, width, height);
+}
+
+void law_setPos(law_Window window, int x, int y) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL || __law_recordPos(window, x, y) || (win->x == x && win->y == y))
+    return;
+
+  win->x = x;
+  win->y = y;
+  __law_headlessNotify(window, LAW_EVENT_MOVE, x, y);
+}
+
+void law_getSize(law_Window window, int* width, int* height) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  *width = win ? win->width : 0;
+  *height = win ? win->height : 0;
+}
+
+void law_getPos(law_Window window, int* x, int* y) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  *x = win ? win->x : 0;
+  *y = win ? win->y : 0;
+}
+
+void law_hide(law_Window window) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL || !win->visible)
+    return;
+
+  win->visible = 0;
+  __law_headlessNotify(window, LAW_EVENT_HIDE, 0, 0);
+}
+
+void law_show(law_Window window) {
+  __law_HeadlessWindow* win = (__law_HeadlessWindow*)__law_lookup(window);
+  if (win == NULL || win->visible)
+    return;
+
+  win->visible = 1;
+  __law_headlessNotify(window, LAW_EVENT_SHOW, 0, 0);
+}
+
+void law_minimize(law_Window window) {
+  (void)window; // Nothing to do without a screen
+}
+
+void law_maximize(law_Window window) {
+  (void)window; // Nothing to do without a screen
+}
+
+static void __law_showMany(const law_Window* windows, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    law_show(windows[i]);
+}
+
+static void __law_applyChanges(__law_State* state, const __law_Transaction* transaction) {
+  // Outside of the transaction, the setters apply the changes (one event per property)
+  if (transaction->changes & __LAW_CHANGE_POS)
+    law_setPos(state->window, transaction->x, transaction->y);
+  if (transaction->changes & __LAW_CHANGE_SIZE)
+    law_setSize(state->window, transaction->width, transaction->height);
+  if (transaction->changes & __LAW_CHANGE_TITLE)
+    law_setTitle(state->window, transaction->title);
+}
+
+#pragma endregion _window
+
+#pragma region _cursors
+#ifndef LAW_NO_CURSOR
+
+// Nothing to show the image on, only its size and hot spot are kept
+typedef struct {
+  int width, height;
+  int hot_x, hot_y;
+} __law_HeadlessCursor;
+
+law_Cursor law_createCursor(const unsigned int* pixels, int width, int height, int hot_x, int hot_y) {
+  if (pixels == NULL || width <= 0 || height <= 0)
+    return NULL;
+
+  __law_HeadlessCursor* cursor = (__law_HeadlessCursor*)malloc(sizeof(__law_HeadlessCursor));
+  if (cursor == NULL) {
+    assert(0 && "Failed to allocate memory for the cursor");
+    law_error = LAW_ERROR_ALLOCATE_MEMORY_FOR_PARAMS;
+    return NULL;
+  }
+  cursor->width = width;
+  cursor->height = height;
+  cursor->hot_x = hot_x;
+  cursor->hot_y = hot_y;
+  return (law_Cursor)cursor;
+}
+
+void law_destroyCursor(law_Cursor cursor) {
+  free(cursor);
+}
+
+void law_setCursor(law_Window window, law_Cursor cursor) {
+  __law_State* state = __law_lookup(window);
+  if (state)
+    state->cursor = cursor;
+}
+
+#endif // LAW_NO_CURSOR
+#pragma endregion _cursors
+
+#endif // LA_WINDOW_IMPLEMENTATION
+#endif // LAW_HEADLESS
+#pragma endregion headless
+
+
 const char* law_getErrorMsg(unsigned int error_code) {
   assert(error_code >= 0 && error_code < 3);
 
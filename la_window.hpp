@@ -0,0 +1,532 @@
+/**
+ * @file la_window.hpp
+ * @brief C++17 wrapper for la_window.h with compile-time event binding.
+ *
+ * This file is part of the la-window project by the
+ * la-lib organization <https://github.com/la-lib>
+ * For more information visit <https://lalib.eu>
+ *
+ * @section license
+ *
+ * Copyright (C) 2024 la-lib and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of either:
+ *
+ * 1) the GNU General Public License as published by the Free Software Foundation,
+ *    either version 3 of the License, or (at your option) any later version, or
+ *
+ * 2) the GNU Lesser General Public License as published by the Free Software Foundation,
+ *    either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License or the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+// ------------------- Usage -------------------
+/*
+  Include this header instead of 'la_window.h' (C++17 or newer),
+  'LA_WINDOW_IMPLEMENTATION' works the same way.
+
+  The handler is a plain class, its member functions are detected at
+  compile time. Event types without a member function are never
+  subscribed (the core filters them before they are queued), and the
+  member functions of the handled ones are inlined into a single dispatch
+  function, there is no function pointer per event type.
+
+    struct Game {
+      int score = 0;
+      void onClose(law::WindowRef window) { window.setRunning(false); }
+      void onKeyDown(law::WindowRef window, int key) { if (key == LAW_KEY_SPACE) score++; }
+    };
+
+    law::Window<Game> game(800, 600, L"Game");
+    while (game.running())
+      law::update();
+
+  Handler member functions (all optional):
+    onDestroy(WindowRef)         onClose(WindowRef)
+    onResize(WindowRef, int width, int height)
+    onMove(WindowRef, int x, int y)
+    onFocus(WindowRef)           onUnfocus(WindowRef)
+    onRedraw(WindowRef)          onMinimize(WindowRef)
+    onMaximize(WindowRef)        onShow(WindowRef)
+    onHide(WindowRef)            onTouch(WindowRef, int x, int y)
+    onKeyDown(WindowRef, int key)    onKeyUp(WindowRef, int key)
+    onText(WindowRef, unsigned int codepoint)
+    onMouseMove(WindowRef, int x, int y)
+    onMouseDown(WindowRef, int button)   onMouseUp(WindowRef, int button)
+    onMouseWheel(WindowRef, int wheel)
+    onPen(WindowRef, const law_Event& event)
+
+  With C++20 coroutines, flows spanning several events are written
+  linearly. The awaits are resumed by `law::update`, a coroutine frame
+  comes from a preallocated pool and the awaits allocate nothing.
+
+    law::Task maximizeFlow(law::Window<Game>& game) {
+      for (;;) {
+        law_Event event = co_await game.nextEvent(LAW_EVENT_MASK(LAW_EVENT_MAXIMIZE));
+        if (event.type == LAW_EVENT_DESTROY) co_return;
+        game.maximize();
+        co_await law::sleep(500);      // Resumed by the first update after 500 ms
+        co_await game.frame();         // Resumed by the next update
+      }
+    }
+*/
+
+
+#ifndef __LA_WIN_HPP_HEADER_GUARD
+#define __LA_WIN_HPP_HEADER_GUARD
+
+#include "la_window.h"
+
+#include <type_traits> // For std::void_t, std::true_type
+#include <utility>     // For std::declval, std::forward
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <chrono>    // For std::chrono::steady_clock
+#include <coroutine> // For std::coroutine_handle
+#include <cstddef>   // For std::max_align_t
+#include <cstdint>   // For uintptr_t
+#include <exception> // For std::terminate
+#include <new>       // For operator new
+#define LAW_COROUTINES 1
+#endif
+#endif
+
+#ifdef LAW_COROUTINES
+#ifndef LAW_COROUTINE_FRAMES
+  #define LAW_COROUTINE_FRAMES 64 // Number of preallocated coroutine frames
+#endif
+#ifndef LAW_COROUTINE_FRAME_SIZE
+  #define LAW_COROUTINE_FRAME_SIZE 1024 // Size of a preallocated coroutine frame (bytes)
+#endif
+#endif // LAW_COROUTINES
+
+namespace law {
+
+/**
+ * @brief Non-owning reference to a window.
+ *
+ * Passed to the handler member functions, it's a single pointer
+ * and costs nothing to copy.
+ */
+class WindowRef {
+public:
+  WindowRef(law_Window window = nullptr) : window_(window) {}
+
+  law_Window native() const { return window_; }
+  explicit operator bool() const { return window_ != nullptr; }
+
+  law_Data* data() const { return law_getData(window_); }
+  bool running() const { return window_ && law_getData(window_)->running; }
+  void setRunning(bool running) const { law_getData(window_)->running = running; }
+
+  void setTitle(const wchar_t* title) const { law_setTitle(window_, title); }
+  const wchar_t* title() const { return law_getTitle(window_); }
+  void setSize(int width, int height) const { law_setSize(window_, width, height); }
+  void getSize(int* width, int* height) const { law_getSize(window_, width, height); }
+  void setPos(int x, int y) const { law_setPos(window_, x, y); }
+  void getPos(int* x, int* y) const { law_getPos(window_, x, y); }
+  void show() const { law_show(window_); }
+  void hide() const { law_hide(window_); }
+  void minimize() const { law_minimize(window_); }
+  void maximize() const { law_maximize(window_); }
+  int postEvent(const law_Event& event) const { return law_postEvent(window_, &event); }
+
+protected:
+  law_Window window_;
+};
+
+#ifdef LAW_COROUTINES
+#pragma region _coroutines
+
+namespace detail {
+
+// Preallocated coroutine frames, bigger frames or frames beyond the pool are allocated on the heap
+struct FramePool {
+  union Block {
+    Block* next;
+    alignas(alignof(std::max_align_t)) unsigned char bytes[LAW_COROUTINE_FRAME_SIZE];
+  };
+
+  Block blocks[LAW_COROUTINE_FRAMES];
+  Block* free_list; // Released blocks
+  size_t carved;    // Blocks handed out at least once
+  size_t used;      // Blocks in use
+
+  void* allocate(size_t size) {
+    if (size > sizeof(Block))
+      return ::operator new(size);
+
+    Block* block = free_list;
+    if (block)
+      free_list = block->next;
+    else if (carved < LAW_COROUTINE_FRAMES)
+      block = &blocks[carved++];
+    else
+      return ::operator new(size);
+
+    used++;
+    return block;
+  }
+
+  void deallocate(void* frame) {
+    uintptr_t address = (uintptr_t)frame;
+    if (address < (uintptr_t)blocks || address >= (uintptr_t)(blocks + LAW_COROUTINE_FRAMES)) {
+      ::operator delete(frame);
+      return;
+    }
+
+    Block* block = static_cast<Block*>(frame);
+    block->next = free_list;
+    free_list = block;
+    used--;
+  }
+};
+
+inline FramePool frame_pool; // Zero-initialized, no constructor runs
+
+// Suspended coroutine waiting for an update, the node lives in the awaiter (in the coroutine frame)
+struct Waiter {
+  std::coroutine_handle<> handle;
+  std::chrono::steady_clock::time_point deadline;
+  Waiter* next;
+};
+
+// FIFO of waiters
+struct WaiterQueue {
+  Waiter* head;
+  Waiter* tail;
+
+  void push(Waiter* waiter) {
+    waiter->next = nullptr;
+    if (tail)
+      tail->next = waiter;
+    else
+      head = waiter;
+    tail = waiter;
+  }
+};
+
+inline WaiterQueue frame_waiters; // `frame()`, resumed by the next update
+inline WaiterQueue sleep_waiters; // `sleep(ms)`, resumed by the first update after the deadline
+
+// Resume the waiters of the update (the resumed coroutines may wait again, for the next one)
+inline void resumeWaiters() {
+  WaiterQueue due = frame_waiters;
+  frame_waiters = WaiterQueue{};
+
+  if (sleep_waiters.head) {
+    auto now = std::chrono::steady_clock::now();
+    WaiterQueue pending = {};
+    for (Waiter* waiter = sleep_waiters.head; waiter;) {
+      Waiter* next = waiter->next;
+      (waiter->deadline <= now ? due : pending).push(waiter);
+      waiter = next;
+    }
+    sleep_waiters = pending;
+  }
+
+  for (Waiter* waiter = due.head; waiter;) {
+    Waiter* next = waiter->next; // The node is gone once the coroutine is resumed
+    waiter->handle.resume();
+    waiter = next;
+  }
+}
+
+struct FrameAwaiter : Waiter {
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle) noexcept {
+    this->handle = handle;
+    frame_waiters.push(this);
+  }
+  void await_resume() const noexcept {}
+};
+
+struct SleepAwaiter : Waiter {
+  int ms;
+
+  bool await_ready() const noexcept { return ms <= 0; }
+  void await_suspend(std::coroutine_handle<> handle) noexcept {
+    this->handle = handle;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    sleep_waiters.push(this);
+  }
+  void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @brief A coroutine driven by `law::update`.
+ *
+ * Starts running when called and owns itself, its frame is released
+ * when it returns. Frames up to `LAW_COROUTINE_FRAME_SIZE` bytes come
+ * from a pool of `LAW_COROUTINE_FRAMES` preallocated frames.
+ */
+class Task {
+public:
+  struct promise_type {
+    Task get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    static void* operator new(size_t size) { return detail::frame_pool.allocate(size); }
+    static void operator delete(void* frame) noexcept { detail::frame_pool.deallocate(frame); }
+  };
+};
+
+/**
+ * @brief Wait for the next `law::update`.
+ * @return The awaitable (`co_await law::frame()`). */
+inline detail::FrameAwaiter frame() {
+  return {};
+}
+
+/**
+ * @brief Wait for at least `ms` milliseconds.
+ *
+ * The coroutine is resumed by the first `law::update` after the time elapsed.
+ * @param ms The time to wait (milliseconds).
+ * @return The awaitable (`co_await law::sleep(ms)`). */
+inline detail::SleepAwaiter sleep(int ms) {
+  detail::SleepAwaiter awaiter = {};
+  awaiter.ms = ms;
+  return awaiter;
+}
+
+#pragma endregion _coroutines
+#endif // LAW_COROUTINES
+
+/**
+ * @brief Process window events.
+ *
+ * Calls `law_update`, then resumes the coroutines waiting for
+ * the update (`law::frame`, `law::sleep`).
+ * @param window The window or nullptr to process all windows. */
+inline void update(law_Window window = nullptr) {
+  law_update(window);
+#ifdef LAW_COROUTINES
+  detail::resumeWaiters();
+#endif
+}
+
+/**
+ * @brief Process window events within a time budget (see `law_updateFor`).
+ *
+ * The coroutines waiting for the update are resumed even if the budget ran out.
+ * @param window The window or nullptr to process all windows,
+ * @param budget_ns The time budget (nanoseconds).
+ * @return True if the budget ran out. */
+inline bool updateFor(law_Window window, unsigned long long budget_ns) {
+  bool spent = law_updateFor(window, budget_ns) != 0;
+#ifdef LAW_COROUTINES
+  detail::resumeWaiters();
+#endif
+  return spent;
+}
+
+namespace detail {
+
+// Detects `handler.name(WindowRef, args...)`
+#define __LAW_DETECT(name, args) \
+  template <class H, class = void> struct has_##name : std::false_type {}; \
+  template <class H> struct has_##name<H, std::void_t<decltype(std::declval<H&>().name args)>> : std::true_type {};
+
+__LAW_DETECT(onDestroy, (std::declval<WindowRef>()))
+__LAW_DETECT(onClose, (std::declval<WindowRef>()))
+__LAW_DETECT(onResize, (std::declval<WindowRef>(), 0, 0))
+__LAW_DETECT(onMove, (std::declval<WindowRef>(), 0, 0))
+__LAW_DETECT(onFocus, (std::declval<WindowRef>()))
+__LAW_DETECT(onUnfocus, (std::declval<WindowRef>()))
+__LAW_DETECT(onRedraw, (std::declval<WindowRef>()))
+__LAW_DETECT(onMinimize, (std::declval<WindowRef>()))
+__LAW_DETECT(onMaximize, (std::declval<WindowRef>()))
+__LAW_DETECT(onShow, (std::declval<WindowRef>()))
+__LAW_DETECT(onHide, (std::declval<WindowRef>()))
+__LAW_DETECT(onTouch, (std::declval<WindowRef>(), 0, 0))
+__LAW_DETECT(onKeyDown, (std::declval<WindowRef>(), 0))
+__LAW_DETECT(onKeyUp, (std::declval<WindowRef>(), 0))
+__LAW_DETECT(onText, (std::declval<WindowRef>(), 0u))
+__LAW_DETECT(onMouseMove, (std::declval<WindowRef>(), 0, 0))
+__LAW_DETECT(onMouseDown, (std::declval<WindowRef>(), 0))
+__LAW_DETECT(onMouseUp, (std::declval<WindowRef>(), 0))
+__LAW_DETECT(onMouseWheel, (std::declval<WindowRef>(), 0))
+__LAW_DETECT(onPen, (std::declval<WindowRef>(), std::declval<const law_Event&>()))
+
+#undef __LAW_DETECT
+
+// Event types handled by `H` (LAW_EVENT_MASK)
+template <class H>
+constexpr unsigned int eventMask() {
+  return (has_onDestroy<H>::value ? LAW_EVENT_MASK(LAW_EVENT_DESTROY) : 0u)
+    | (has_onClose<H>::value ? LAW_EVENT_MASK(LAW_EVENT_CLOSE) : 0u)
+    | (has_onResize<H>::value ? LAW_EVENT_MASK(LAW_EVENT_RESIZE) : 0u)
+    | (has_onMove<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MOVE) : 0u)
+    | (has_onFocus<H>::value ? LAW_EVENT_MASK(LAW_EVENT_FOCUS) : 0u)
+    | (has_onUnfocus<H>::value ? LAW_EVENT_MASK(LAW_EVENT_UNFOCUS) : 0u)
+    | (has_onRedraw<H>::value ? LAW_EVENT_MASK(LAW_EVENT_REDRAW) : 0u)
+    | (has_onMinimize<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MINIMIZE) : 0u)
+    | (has_onMaximize<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MAXIMIZE) : 0u)
+    | (has_onShow<H>::value ? LAW_EVENT_MASK(LAW_EVENT_SHOW) : 0u)
+    | (has_onHide<H>::value ? LAW_EVENT_MASK(LAW_EVENT_HIDE) : 0u)
+    | (has_onTouch<H>::value ? LAW_EVENT_MASK(LAW_EVENT_TOUCH) : 0u)
+    | (has_onKeyDown<H>::value ? LAW_EVENT_MASK(LAW_EVENT_KEY_DOWN) : 0u)
+    | (has_onKeyUp<H>::value ? LAW_EVENT_MASK(LAW_EVENT_KEY_UP) : 0u)
+    | (has_onText<H>::value ? LAW_EVENT_MASK(LAW_EVENT_TEXT) : 0u)
+    | (has_onMouseMove<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MOUSE_MOVE) : 0u)
+    | (has_onMouseDown<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MOUSE_DOWN) : 0u)
+    | (has_onMouseUp<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MOUSE_UP) : 0u)
+    | (has_onMouseWheel<H>::value ? LAW_EVENT_MASK(LAW_EVENT_MOUSE_WHEEL) : 0u)
+    | (has_onPen<H>::value ? LAW_EVENT_MASK(LAW_EVENT_PEN) : 0u);
+}
+
+// Call the member function of `handler` for the event (the switch only
+// contains the types `H` handles, the calls are inlined)
+template <class H>
+inline void dispatch(H& handler, WindowRef window, const law_Event& event) {
+  switch (event.type) {
+  case LAW_EVENT_DESTROY: if constexpr (has_onDestroy<H>::value) handler.onDestroy(window); break;
+  case LAW_EVENT_CLOSE: if constexpr (has_onClose<H>::value) handler.onClose(window); break;
+  case LAW_EVENT_RESIZE: if constexpr (has_onResize<H>::value) handler.onResize(window, event.size.width, event.size.height); break;
+  case LAW_EVENT_MOVE: if constexpr (has_onMove<H>::value) handler.onMove(window, event.pos.x, event.pos.y); break;
+  case LAW_EVENT_FOCUS: if constexpr (has_onFocus<H>::value) handler.onFocus(window); break;
+  case LAW_EVENT_UNFOCUS: if constexpr (has_onUnfocus<H>::value) handler.onUnfocus(window); break;
+  case LAW_EVENT_REDRAW: if constexpr (has_onRedraw<H>::value) handler.onRedraw(window); break;
+  case LAW_EVENT_MINIMIZE: if constexpr (has_onMinimize<H>::value) handler.onMinimize(window); break;
+  case LAW_EVENT_MAXIMIZE: if constexpr (has_onMaximize<H>::value) handler.onMaximize(window); break;
+  case LAW_EVENT_SHOW: if constexpr (has_onShow<H>::value) handler.onShow(window); break;
+  case LAW_EVENT_HIDE: if constexpr (has_onHide<H>::value) handler.onHide(window); break;
+  case LAW_EVENT_TOUCH: if constexpr (has_onTouch<H>::value) handler.onTouch(window, event.pos.x, event.pos.y); break;
+  case LAW_EVENT_KEY_DOWN: if constexpr (has_onKeyDown<H>::value) handler.onKeyDown(window, event.key); break;
+  case LAW_EVENT_KEY_UP: if constexpr (has_onKeyUp<H>::value) handler.onKeyUp(window, event.key); break;
+  case LAW_EVENT_TEXT: if constexpr (has_onText<H>::value) handler.onText(window, event.codepoint); break;
+  case LAW_EVENT_MOUSE_MOVE: if constexpr (has_onMouseMove<H>::value) handler.onMouseMove(window, event.pos.x, event.pos.y); break;
+  case LAW_EVENT_MOUSE_DOWN: if constexpr (has_onMouseDown<H>::value) handler.onMouseDown(window, event.button); break;
+  case LAW_EVENT_MOUSE_UP: if constexpr (has_onMouseUp<H>::value) handler.onMouseUp(window, event.button); break;
+  case LAW_EVENT_MOUSE_WHEEL: if constexpr (has_onMouseWheel<H>::value) handler.onMouseWheel(window, event.wheel); break;
+  case LAW_EVENT_PEN: if constexpr (has_onPen<H>::value) handler.onPen(window, event); break;
+  default: break;
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief A window owning its handler.
+ *
+ * The window is created by the constructor and destroyed by the destructor,
+ * the handler is constructed from the remaining constructor arguments.
+ * `law_Data::user_data` points to the `Window` and must not be changed.
+ *
+ * @note Not copyable or movable, the native window refers to this object.
+ */
+template <class Handler>
+class Window : public WindowRef {
+public:
+  // Event types delivered to the handler
+  static constexpr unsigned int event_mask = detail::eventMask<Handler>();
+
+  template <class... Args>
+  Window(int width, int height, const wchar_t* title = L"", Args&&... args)
+    : WindowRef(law_create(width, height, title, nullptr)), handler_(std::forward<Args>(args)...) {
+    if (window_ == nullptr)
+      return;
+
+    law_getData(window_)->user_data = this;
+    if constexpr (event_mask != 0)
+      law_setEventHandler(window_, &Window::dispatch, event_mask);
+  }
+
+  ~Window() {
+    if (window_)
+      law_destroy(window_); // `onDestroy` is called with the handler still alive
+  }
+
+  Window(const Window&) = delete;
+  Window& operator=(const Window&) = delete;
+
+  Handler& handler() { return handler_; }
+  const Handler& handler() const { return handler_; }
+  Handler* operator->() { return &handler_; }
+  const Handler* operator->() const { return &handler_; }
+
+#ifdef LAW_COROUTINES
+  struct EventAwaiter {
+    Window* window;
+    unsigned int mask;
+    law_Event event;
+    std::coroutine_handle<> handle;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+      this->handle = handle;
+      window->wait(this);
+    }
+    law_Event await_resume() const noexcept { return event; }
+  };
+
+  /**
+   * @brief Wait for the next event of the window.
+   *
+   * The event types in `mask` are subscribed while waiting, the coroutine
+   * is resumed during `law_update` right after the handler of the event.
+   * Only one coroutine can wait for the events of a window at a time.
+   * @param mask The event types (`LAW_EVENT_MASK(LAW_EVENT_*)` combined with `|`).
+   * @return The awaitable, `co_await` gives the `law_Event`; it's
+   *         `LAW_EVENT_DESTROY` if the window was destroyed (the window can not be used anymore). */
+  EventAwaiter nextEvent(unsigned int mask = LAW_EVENT_MASK_ALL) {
+    return { this, mask | LAW_EVENT_MASK(LAW_EVENT_DESTROY), {}, nullptr };
+  }
+
+  /**
+   * @brief Wait for the next `law::update`.
+   * @return The awaitable (`co_await window.frame()`). */
+  detail::FrameAwaiter frame() const {
+    return law::frame();
+  }
+#endif // LAW_COROUTINES
+
+private:
+  static void dispatch(law_Window window, law_Data* data, const law_Event* event) {
+    Window* self = static_cast<Window*>(data->user_data);
+    detail::dispatch(self->handler_, WindowRef(window), *event);
+
+#ifdef LAW_COROUTINES
+    EventAwaiter* waiter = self->waiter_;
+    if (waiter && (waiter->mask & LAW_EVENT_MASK(event->type))) {
+      self->waiter_ = nullptr;
+      law_setEventHandler(window, &Window::dispatch, event_mask);
+      waiter->event = *event;
+      waiter->handle.resume(); // The window may be gone after this
+    }
+#endif
+  }
+
+#ifdef LAW_COROUTINES
+  void wait(EventAwaiter* waiter) {
+    assert(waiter_ == nullptr && "Only one coroutine can wait for the events of a window");
+    waiter_ = waiter;
+    law_setEventHandler(window_, &Window::dispatch, event_mask | waiter->mask);
+  }
+
+  EventAwaiter* waiter_ = nullptr; // Coroutine waiting for an event
+#endif
+
+  Handler handler_;
+};
+
+} // namespace law
+
+#endif // __LA_WIN_HPP_HEADER_GUARD
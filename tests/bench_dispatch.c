@@ -0,0 +1,75 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Measures the shared event core (posting, filtering, coalescing, dispatch)
+// with the headless backend
+
+#define EVENTS 4000000   // Events per scenario
+#define PER_UPDATE 1000  // Events posted between two updates
+
+static volatile long long sink = 0;
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  sink += key;
+}
+
+static void on_mouse_move(law_Window window, law_Data* win_data, int x, int y) {
+  sink += x + y;
+}
+
+static void on_batch(law_Window window, law_Data* win_data, const law_Event* events, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    sink += events[i].type == LAW_EVENT_MOUSE_MOVE ? events[i].pos.x + events[i].pos.y : events[i].key;
+}
+
+static double seconds(void) {
+  return (double)__law_now() / 1e6;
+}
+
+static void bench(const char* name, law_Window window, const law_Event* pattern, int pattern_length) {
+  double start = seconds();
+  for (int i = 0; i < EVENTS; i += PER_UPDATE) {
+    for (int j = 0; j < PER_UPDATE; j++)
+      law_postEvent(window, &pattern[j % pattern_length]);
+    law_update(NULL);
+  }
+  double elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/event\n", name, elapsed * 1e9 / EVENTS);
+}
+
+int main(int argc, char *argv[]) {
+  law_Window win = law_create(400, 100, L"Benchmark", NULL);
+  if (!win) return 1;
+
+  law_Data* windata = law_getData(win);
+  windata->event.key.down = on_key;
+  windata->event.key.up = on_key;
+  windata->event.mouse.move = on_mouse_move;
+
+  law_Event keys[2] = { { LAW_EVENT_KEY_DOWN }, { LAW_EVENT_KEY_UP } };
+  keys[0].key = keys[1].key = LAW_KEY_A;
+
+  law_Event moves[1] = { { LAW_EVENT_MOUSE_MOVE } };
+  moves[0].pos.x = 10;
+  moves[0].pos.y = 20;
+
+  law_Event mixed[4] = { { LAW_EVENT_MOUSE_MOVE }, { LAW_EVENT_MOUSE_MOVE }, { LAW_EVENT_KEY_DOWN }, { LAW_EVENT_KEY_UP } };
+
+  law_Event unhandled[1] = { { LAW_EVENT_MOUSE_WHEEL } };
+
+  bench("key down/up (dispatched)", win, keys, 2);
+  bench("mouse move (coalesced)", win, moves, 1);
+  bench("mouse move + keys (mixed)", win, mixed, 4);
+  bench("mouse wheel (filtered)", win, unhandled, 1);
+
+  // The same events delivered as one array per update
+  law_setBatchHandler(win, on_batch);
+  bench("key down/up (batch handler)", win, keys, 2);
+  bench("mouse move + keys (batch handler)", win, mixed, 4);
+
+  law_destroy(win);
+  return sink == 42; // Keep the handlers from being optimized away
+}
@@ -0,0 +1,95 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Measures the parallel dispatch of independent windows with 1 to 32 threads
+
+#define WINDOWS 64
+#define EVENTS 64   // Key events per window and update
+#define UPDATES 50
+#define WORK 2000   // Iterations of the handler, simulated per-event work
+
+typedef struct {
+  int last_key;     // Events of a window must stay in order
+  int out_of_order;
+  int redraws;
+  unsigned int hash;
+} Counter;
+
+static law_Window windows[WINDOWS];
+static Counter counters[WINDOWS];
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  Counter* counter = (Counter*)win_data->user_data;
+  if (key != counter->last_key + 1)
+    counter->out_of_order++;
+  counter->last_key = key;
+
+  unsigned int hash = counter->hash;
+  for (int i = 0; i < WORK; i++)
+    hash = hash * 2654435761u + (unsigned int)i;
+  counter->hash = hash;
+}
+
+static void on_redraw(law_Window window, law_Data* win_data) {
+  ((Counter*)win_data->user_data)->redraws++;
+}
+
+static double seconds(void) {
+  return (double)__law_now() / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+  for (int i = 0; i < WINDOWS; i++) {
+    windows[i] = law_create(100, 100, L"Window", NULL);
+    if (!windows[i]) return 1;
+    law_Data* data = law_getData(windows[i]);
+    data->user_data = &counters[i];
+    data->event.key.down = on_key;
+    data->event.window.redraw = on_redraw;
+  }
+
+  double serial = 0.0;
+  for (int threads = 1; threads <= 32; threads *= 2) {
+    int used = law_setDispatchThreads(threads);
+    for (int i = 0; i < WINDOWS; i++)
+      counters[i].last_key = 0;
+
+    double start = seconds();
+    for (int update = 0; update < UPDATES; update++) {
+      for (int i = 0; i < WINDOWS; i++) {
+        for (int key = 1; key <= EVENTS; key++) {
+          law_Event event = { LAW_EVENT_KEY_DOWN };
+          event.key = update * EVENTS + key;
+          law_postEvent(windows[i], &event);
+        }
+        law_Event redraw = { LAW_EVENT_REDRAW };
+        law_postEvent(windows[i], &redraw);
+      }
+      law_update(NULL);
+    }
+    double elapsed = seconds() - start;
+    if (threads == 1)
+      serial = elapsed;
+
+    printf("%2d threads %9.1f us/update %6.2fx\n", used, elapsed * 1e6 / UPDATES, serial / elapsed);
+  }
+  law_setDispatchThreads(0);
+
+  for (int i = 0; i < WINDOWS; i++) {
+    if (counters[i].out_of_order || counters[i].last_key != UPDATES * EVENTS) {
+      printf("window %d: events out of order\n", i);
+      return 1;
+    }
+    if (counters[i].redraws != 6 * UPDATES) {
+      printf("window %d: %d redraws\n", i, counters[i].redraws);
+      return 1;
+    }
+  }
+
+  for (int i = 0; i < WINDOWS; i++)
+    law_destroy(windows[i]);
+  return 0;
+}
@@ -0,0 +1,91 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Measures the native ID -> window data lookups with 10,000 live headless windows
+
+#define WINDOWS 10000
+#define LOOKUPS 10000000
+#define EVENTS 2000000
+
+static law_Window windows[WINDOWS];
+static volatile long long sink = 0;
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  sink += key;
+}
+
+static double seconds(void) {
+  return (double)__law_now() / 1e6;
+}
+
+// Pseudo-random window index (xorshift), lookups do not follow the creation order
+static unsigned int next_index(unsigned int* seed) {
+  *seed ^= *seed << 13;
+  *seed ^= *seed >> 17;
+  *seed ^= *seed << 5;
+  return *seed % WINDOWS;
+}
+
+// Linear search, what a lookup costs without the registry
+static law_Data* linear_lookup(law_Window window) {
+  for (int i = 0; i < WINDOWS; i++)
+    if (windows[i] == window)
+      return law_getData(windows[i]);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  for (int i = 0; i < WINDOWS; i++) {
+    windows[i] = law_create(100, 100, L"Window", NULL);
+    if (!windows[i]) return 1;
+    law_getData(windows[i])->event.key.down = on_key;
+  }
+
+  unsigned int seed = 2463534242u;
+  double start = seconds();
+  for (int i = 0; i < LOOKUPS; i++)
+    sink += law_getData(windows[next_index(&seed)])->running;
+  double elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/lookup\n", "registry lookup", elapsed * 1e9 / LOOKUPS);
+
+  start = seconds();
+  for (int i = 0; i < LOOKUPS / 1000; i++)
+    sink += linear_lookup(windows[next_index(&seed)])->running;
+  elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/lookup\n", "linear search", elapsed * 1e9 / (LOOKUPS / 1000));
+
+  // Posting and dispatching an event looks the window up once
+  law_Event event = { LAW_EVENT_KEY_DOWN };
+  event.key = LAW_KEY_A;
+  start = seconds();
+  for (int i = 0; i < EVENTS; i += 1000) {
+    for (int j = 0; j < 1000; j++)
+      law_postEvent(windows[next_index(&seed)], &event);
+    law_update(NULL);
+  }
+  elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/event\n", "post + dispatch", elapsed * 1e9 / EVENTS);
+
+  // Destroying and creating windows keeps the lookups short (no tombstones)
+  start = seconds();
+  for (int i = 0; i < WINDOWS * 10; i++) {
+    unsigned int index = next_index(&seed);
+    law_destroy(windows[index]);
+    windows[index] = law_create(100, 100, L"Window", NULL);
+  }
+  elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/window\n", "destroy + create", elapsed * 1e9 / (WINDOWS * 10));
+
+  start = seconds();
+  for (int i = 0; i < LOOKUPS; i++)
+    sink += law_getData(windows[next_index(&seed)])->running;
+  elapsed = seconds() - start;
+  printf("%-32s %7.1f ns/lookup\n", "registry lookup after churn", elapsed * 1e9 / LOOKUPS);
+
+  for (int i = 0; i < WINDOWS; i++)
+    law_destroy(windows[i]);
+  return sink == 42; // Keep the lookups from being optimized away
+}
@@ -0,0 +1,101 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.hpp"
+
+#include <stdio.h>
+#include <wchar.h>
+
+// Checks the coroutine awaitables of the C++ wrapper with the headless backend (C++20)
+
+#ifndef LAW_COROUTINES
+#error "The compiler has no coroutine support"
+#endif
+
+struct Empty {};
+
+static int failed = 0;
+
+static void check(int condition, const char* what) {
+  if (!condition) {
+    printf("FAILED: %s\n", what);
+    failed = 1;
+  }
+}
+
+// The `on_maximize` / `another_maximize` ping-pong of test_window.c, written linearly
+static law::Task maximizeFlow(law::Window<Empty>& win, int* steps) {
+  for (;;) {
+    law_Event event = co_await win.nextEvent(LAW_EVENT_MASK(LAW_EVENT_MAXIMIZE));
+    if (event.type == LAW_EVENT_DESTROY)
+      co_return;
+    win.setTitle(L"Maximized Window");
+    (*steps)++;
+
+    event = co_await win.nextEvent(LAW_EVENT_MASK(LAW_EVENT_MAXIMIZE));
+    if (event.type == LAW_EVENT_DESTROY)
+      co_return;
+    win.setTitle(L"Maximized(another) Window");
+    (*steps)++;
+  }
+}
+
+static law::Task frameCounter(int frames, int* counted) {
+  for (int i = 0; i < frames; i++) {
+    co_await law::frame();
+    (*counted)++;
+  }
+}
+
+static law::Task sleeper(int* woken) {
+  co_await law::sleep(20);
+  (*woken)++;
+}
+
+static void post(law::WindowRef window, int type) {
+  law_Event event = {};
+  event.type = type;
+  window.postEvent(event);
+}
+
+int main(int argc, char *argv[]) {
+  int steps = 0;
+  {
+    law::Window<Empty> win(400, 100, L"Coroutine");
+    maximizeFlow(win, &steps);
+    check(law::detail::frame_pool.used == 1, "frame from the pool");
+
+    post(win, LAW_EVENT_CLOSE); // Not awaited, filtered
+    post(win, LAW_EVENT_MAXIMIZE);
+    law::update();
+    check(steps == 1 && wcscmp(win.title(), L"Maximized Window") == 0, "first maximize");
+
+    post(win, LAW_EVENT_MAXIMIZE);
+    law::update();
+    check(steps == 2 && wcscmp(win.title(), L"Maximized(another) Window") == 0, "second maximize");
+
+    post(win, LAW_EVENT_MAXIMIZE);
+    law::update();
+    check(steps == 3 && wcscmp(win.title(), L"Maximized Window") == 0, "third maximize");
+  }
+  check(law::detail::frame_pool.used == 0, "destroy ends the flow");
+
+  int counted = 0;
+  frameCounter(3, &counted);
+  for (int i = 0; i < 5; i++)
+    law::update();
+  check(counted == 3, "one frame per update");
+
+  int woken = 0;
+  sleeper(&woken);
+  law::update();
+  check(woken == 0, "sleep not elapsed");
+  auto start = std::chrono::steady_clock::now();
+  while (!woken && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+    law::update();
+  check(woken == 1 && std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(15), "sleep elapsed");
+  check(law::detail::frame_pool.used == 0, "frames released");
+
+  if (!failed)
+    printf("All coroutine checks passed\n");
+  return failed;
+}
@@ -0,0 +1,102 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Checks `law_createMany` and `law_createManyAsync`: the windows are shown
+// together, the asynchronous ones are announced by the next `law_update`
+
+#define WINDOWS 100 // More than a batch of shown windows
+
+static law_Window windows[WINDOWS];
+static int shown[WINDOWS];
+static int created[WINDOWS];
+static int created_count = 0;
+
+static int indexOf(law_Window window) {
+  for (int i = 0; i < WINDOWS; i++)
+    if (windows[i] == window)
+      return i;
+  return -1;
+}
+
+static void on_show(law_Window window, law_Data* win_data) {
+  shown[indexOf(window)]++;
+}
+
+static void on_created(law_Window window, law_Data* win_data) {
+  created[indexOf(window)]++;
+  created_count++;
+}
+
+static law_CreateInfo infos[WINDOWS];
+
+int main(int argc, char *argv[]) {
+  for (int i = 0; i < WINDOWS; i++) {
+    infos[i].width = 200;
+    infos[i].height = 100;
+    infos[i].title = L"Many";
+    infos[i].show = i % 2 == 0;
+  }
+  int failed = 0;
+
+  // Synchronous, shown before it returns
+  if (law_createMany(infos, WINDOWS, windows) != WINDOWS) {
+    printf("FAILED: law_createMany\n");
+    return 1;
+  }
+  int count = 0;
+  for (int i = 0; i < WINDOWS; i++)
+    count += ((__law_HeadlessWindow*)__law_lookup(windows[i]))->visible == (i % 2 == 0);
+  if (count != WINDOWS) {
+    printf("FAILED: %d windows shown as requested by law_createMany\n", count);
+    failed = 1;
+  }
+  for (int i = 0; i < WINDOWS; i++)
+    law_destroy(windows[i]);
+
+  // Asynchronous, nothing happens before the update
+  if (law_createManyAsync(infos, WINDOWS, windows) != WINDOWS) {
+    printf("FAILED: law_createManyAsync\n");
+    return 1;
+  }
+  for (int i = 0; i < WINDOWS; i++) {
+    law_getData(windows[i])->event.window.show = on_show;
+    law_getData(windows[i])->event.window.created = on_created;
+  }
+  law_destroy(windows[1]); // Never announced
+  windows[1] = NULL;
+
+  count = 0;
+  for (int i = 0; i < WINDOWS; i++)
+    count += shown[i] + created[i];
+  if (count) {
+    printf("FAILED: %d events before the update\n", count);
+    failed = 1;
+  }
+
+  law_update(NULL);
+  count = 0;
+  for (int i = 0; i < WINDOWS; i++)
+    count += created[i] == (i != 1) && shown[i] == (i % 2 == 0);
+  printf("%d of %d windows announced and shown as requested\n", count, WINDOWS);
+  if (count != WINDOWS) {
+    printf("FAILED: law_createManyAsync announcements\n");
+    failed = 1;
+  }
+
+  // Announced once
+  law_update(NULL);
+  if (created_count != WINDOWS - 1) {
+    printf("FAILED: %d created events\n", created_count);
+    failed = 1;
+  }
+
+  for (int i = 0; i < WINDOWS; i++)
+    law_destroy(windows[i]);
+  if (failed)
+    return 1;
+  printf("All create many checks passed\n");
+  return 0;
+}
@@ -0,0 +1,75 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Checks the cursors (`law_createCursor` / `law_setCursor`): switching
+// between created cursors causes no event or redraw of the window
+
+static int events = 0;
+
+static void on_redraw(law_Window window, law_Data* win_data) {
+  events++;
+}
+
+static void on_event(law_Window window, law_Data* win_data, const law_Event* event) {
+  events++;
+}
+
+int main(int argc, char *argv[]) {
+  law_Window window = law_create(400, 100, L"Cursor", NULL);
+  if (!window) return 1;
+  law_getData(window)->event.window.redraw = on_redraw;
+  law_setEventHandler(window, on_event, LAW_EVENT_MASK_ALL & ~LAW_EVENT_MASK(LAW_EVENT_REDRAW));
+  int failed = 0;
+
+  static unsigned int arrow[16 * 16], hand[32 * 32];
+  for (int i = 0; i < 16 * 16; i++)
+    arrow[i] = 0xFF000000;
+  for (int i = 0; i < 32 * 32; i++)
+    hand[i] = 0x80FFFFFF;
+
+  if (law_createCursor(NULL, 16, 16, 0, 0) || law_createCursor(arrow, 0, 16, 0, 0)) {
+    printf("FAILED: cursor of an invalid image\n");
+    failed = 1;
+  }
+
+  law_Cursor cursors[2] = { law_createCursor(arrow, 16, 16, 0, 0), law_createCursor(hand, 32, 32, 8, 2) };
+  if (!cursors[0] || !cursors[1]) {
+    printf("FAILED: law_createCursor\n");
+    return 1;
+  }
+
+  // Hovering regions of the window, the cursors are only switched
+  for (int i = 0; i < 1000; i++)
+    law_setCursor(window, cursors[i % 2]);
+  law_update(NULL);
+  __law_State* state = __law_lookup(window);
+  if (state->cursor != cursors[1] || events) {
+    printf("FAILED: switching cursors (%d events)\n", events);
+    failed = 1;
+  }
+
+  law_setCursor(window, NULL);
+  if (state->cursor) {
+    printf("FAILED: default cursor\n");
+    failed = 1;
+  }
+
+  // A pooled window gets the default cursor back
+  law_setCursor(window, cursors[0]);
+  law_releasePooledWindow(window);
+  if (state->cursor) {
+    printf("FAILED: cursor of a pooled window\n");
+    failed = 1;
+  }
+  law_clearWindowPool();
+
+  law_destroyCursor(cursors[0]);
+  law_destroyCursor(cursors[1]);
+  if (failed)
+    return 1;
+  printf("All cursor checks passed\n");
+  return 0;
+}
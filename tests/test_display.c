@@ -0,0 +1,119 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+// Checks the display connections (`law_openDisplay`): every thread pumps
+// the windows of its own display, and the displays do not see each other
+
+#define DISPLAYS 4
+#define WINDOWS 8
+#define UPDATES 2000
+
+typedef struct {
+  const char* name;
+  law_Window windows[WINDOWS];
+  int keys;           // Key events received
+  int redraws;
+  int foreign;        // Windows of another display found
+  int failed;
+} Connection;
+
+static Connection connections[DISPLAYS];
+static law_Window first_window; // Window of the default display
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  ((Connection*)win_data->user_data)->keys++;
+}
+
+static void on_redraw(law_Window window, law_Data* win_data) {
+  ((Connection*)win_data->user_data)->redraws++;
+}
+
+static void* serve(void* arg) {
+  Connection* connection = (Connection*)arg;
+  law_Display display = law_openDisplay(connection->name);
+  if (display == NULL) {
+    connection->failed = 1;
+    return NULL;
+  }
+
+  for (int i = 0; i < WINDOWS; i++) {
+    connection->windows[i] = law_create(100, 100, L"Window", NULL);
+    if (!connection->windows[i]) {
+      connection->failed = 1;
+      return NULL;
+    }
+    law_Data* data = law_getData(connection->windows[i]);
+    data->user_data = connection;
+    data->event.key.down = on_key;
+    data->event.window.redraw = on_redraw;
+  }
+
+  if (law_getData(first_window))
+    connection->foreign++;
+
+  for (int update = 0; update < UPDATES; update++) {
+    for (int i = 0; i < WINDOWS; i++) {
+      law_Event event = { LAW_EVENT_KEY_DOWN };
+      event.key = LAW_KEY_A;
+      law_postEvent(connection->windows[i], &event);
+      law_Event redraw = { LAW_EVENT_REDRAW };
+      law_postEvent(connection->windows[i], &redraw);
+    }
+    law_update(NULL);
+    if (update % 64 == 0)
+      sched_yield(); // Interleave the threads on a single core too
+  }
+
+  for (int i = 0; i < WINDOWS; i++)
+    law_destroy(connection->windows[i]);
+  law_closeDisplay(display);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  static const char* names[DISPLAYS] = { ":1", ":2", ":3", ":4" };
+
+  first_window = law_create(100, 100, L"Default display", NULL);
+  if (!first_window) return 1;
+
+  pthread_t threads[DISPLAYS];
+  for (int i = 0; i < DISPLAYS; i++) {
+    connections[i].name = names[i];
+    pthread_create(&threads[i], NULL, serve, &connections[i]);
+  }
+  for (int i = 0; i < DISPLAYS; i++)
+    pthread_join(threads[i], NULL);
+
+  int failed = 0;
+  for (int i = 0; i < DISPLAYS; i++) {
+    Connection* connection = &connections[i];
+    if (connection->failed || connection->foreign
+        || connection->keys != WINDOWS * UPDATES || connection->redraws != WINDOWS * UPDATES) {
+      printf("FAILED: display %s, %d keys, %d redraws, %d foreign windows\n",
+        connection->name, connection->keys, connection->redraws, connection->foreign);
+      failed = 1;
+    }
+    // Windows of the other displays are not visible on the default display
+    if (law_getData(connection->windows[0])) {
+      printf("FAILED: window of display %s found on the default display\n", connection->name);
+      failed = 1;
+    }
+  }
+
+  // The default display still works after the others are closed
+  if (!law_getData(first_window)) {
+    printf("FAILED: window of the default display lost\n");
+    failed = 1;
+  }
+  law_destroy(first_window);
+
+  if (failed)
+    return 1;
+  printf("All display checks passed\n");
+  return 0;
+}
@@ -0,0 +1,66 @@
+#define LAW_HEADLESS
+#define LAW_NO_PEN
+#define LAW_NO_TOUCH
+#define LAW_NO_MOUSE
+#define LAW_NO_TEXT
+#define LAW_NO_FRAMEBUFFER
+#define LAW_NO_CURSOR
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Checks a build with every optional subsystem stripped (`LAW_NO_*`):
+// the events of the stripped subsystems are ignored, the others still work
+
+static int keys = 0;
+static int handled = 0;
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  keys++;
+}
+
+static void on_event(law_Window window, law_Data* win_data, const law_Event* event) {
+  handled++;
+}
+
+int main(int argc, char *argv[]) {
+  law_Window window = law_create(400, 100, L"Features", NULL);
+  if (!window) return 1;
+  law_getData(window)->event.key.down = on_key;
+  int failed = 0;
+
+  // Even a handler of all event types gets none of the stripped ones
+  law_setEventHandler(window, on_event, LAW_EVENT_MASK_ALL & ~LAW_EVENT_MASK(LAW_EVENT_KEY_DOWN));
+  static const int stripped[] = {
+    LAW_EVENT_TOUCH, LAW_EVENT_TEXT, LAW_EVENT_MOUSE_MOVE, LAW_EVENT_MOUSE_DOWN,
+    LAW_EVENT_MOUSE_UP, LAW_EVENT_MOUSE_WHEEL, LAW_EVENT_PEN,
+  };
+  for (size_t i = 0; i < sizeof(stripped) / sizeof(stripped[0]); i++) {
+    law_Event event = { stripped[i] };
+    if (law_postEvent(window, &event)) {
+      printf("FAILED: stripped event %d was posted\n", stripped[i]);
+      failed = 1;
+    }
+  }
+
+  law_Event key = { LAW_EVENT_KEY_DOWN };
+  key.key = LAW_KEY_A;
+  law_Event close = { LAW_EVENT_CLOSE };
+  law_postEvent(window, &key);
+  law_postEvent(window, &close);
+  law_update(NULL);
+
+  printf("law_Data %zu bytes, window state %zu bytes, %d keys, %d handled\n",
+    sizeof(law_Data), sizeof(__law_State), keys, handled);
+  if (keys != 1 || handled != 1) {
+    printf("FAILED: kept events\n");
+    failed = 1;
+  }
+
+  law_destroy(window);
+  if (failed)
+    return 1;
+  printf("All feature checks passed\n");
+  return 0;
+}
@@ -0,0 +1,105 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+// Checks the idle wait (`law_setIdleWait`): `law_update` blocks while all
+// windows are hidden, until an event arrives from another thread
+
+#define DELAY_US 200000
+
+static law_Window windows[2];
+static int shown = 0;
+
+static void on_show(law_Window window, law_Data* win_data) {
+  shown++;
+}
+
+static void* wake_later(void* arg) {
+  struct timespec delay = { 0, DELAY_US * 1000 };
+  nanosleep(&delay, NULL);
+  law_Event event = { LAW_EVENT_SHOW };
+  law_postEventFromThread(windows[0], &event);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  law_setIdleWait(1);
+  for (int i = 0; i < 2; i++) {
+    windows[i] = law_create(400, 100, L"Idle", NULL);
+    if (!windows[i]) return 1;
+    law_getData(windows[i])->event.window.show = on_show;
+  }
+  int failed = 0;
+
+  // Visible windows: no wait
+  unsigned long long start = __law_now();
+  law_update(NULL);
+  if (__law_now() - start > DELAY_US / 4) {
+    printf("FAILED: waited with visible windows\n");
+    failed = 1;
+  }
+
+  // A minimize request alone doesn't make the windows idle
+  law_Event minimize = { LAW_EVENT_MINIMIZE };
+  law_postEvent(windows[0], &minimize);
+  law_postEvent(windows[1], &minimize);
+  start = __law_now();
+  law_update(NULL);
+  if (__law_now() - start > DELAY_US / 4) {
+    printf("FAILED: waited after a minimize request\n");
+    failed = 1;
+  }
+
+  law_show(windows[0]);
+  law_show(windows[1]);
+  law_hide(windows[0]);
+  law_hide(windows[1]);
+  law_update(NULL); // Delivers the queued show events, no wait
+
+  // All hidden: blocks until the show event of the other thread
+  pthread_t thread;
+  pthread_create(&thread, NULL, wake_later, NULL);
+  start = __law_now();
+  clock_t cpu_start = clock();
+  law_update(NULL);
+  double cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+  unsigned long long waited = __law_now() - start;
+  pthread_join(thread, NULL);
+
+  printf("waited %.1f ms, %.1f ms CPU, %d shows\n", waited / 1000.0, cpu * 1000.0, shown);
+  if (waited < DELAY_US * 3 / 4 || cpu > 0.05 || shown != 3) {
+    printf("FAILED: idle wait\n");
+    failed = 1;
+  }
+
+  // Shown again: no wait
+  start = __law_now();
+  law_update(NULL);
+  if (__law_now() - start > DELAY_US / 4) {
+    printf("FAILED: waited after the window was shown\n");
+    failed = 1;
+  }
+
+  // Hidden, but law_updateFor and a disabled idle wait return at once
+  law_hide(windows[0]);
+  law_update(NULL);
+  start = __law_now();
+  law_updateFor(NULL, 1000000);
+  law_setIdleWait(0);
+  law_update(NULL);
+  if (__law_now() - start > DELAY_US / 4) {
+    printf("FAILED: waited in law_updateFor or with the idle wait disabled\n");
+    failed = 1;
+  }
+
+  law_destroy(windows[0]);
+  law_destroy(windows[1]);
+  if (failed)
+    return 1;
+  printf("All idle checks passed\n");
+  return 0;
+}
@@ -0,0 +1,129 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+// Checks the input ring (`law_postEventFromThread`) with a producer thread
+// and the main thread consuming with `law_update`, then the ring of a
+// display opened by another thread
+
+#define EVENTS 2000000
+#define DISPLAY_EVENTS 100000
+
+static law_Window win;
+static int expected = 0;   // Next sequence number
+static int out_of_order = 0;
+static unsigned long long latest_time = 0;
+static int backwards = 0;  // Timestamps going back
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  if (key != expected)
+    out_of_order++;
+  expected = key + 1;
+}
+
+static void* producer(void* arg) {
+  law_Event event = { LAW_EVENT_KEY_DOWN };
+  for (int i = 0; i < EVENTS; i++) {
+    event.key = i;
+    event.time = 0; // Timestamped when pushed
+    while (!law_postEventFromThread(win, &event))
+      sched_yield(); // Full, let the main thread run
+  }
+  return NULL;
+}
+
+static void on_batch(law_Window window, law_Data* win_data, const law_Event* events, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (events[i].type != LAW_EVENT_KEY_DOWN)
+      continue;
+    if (events[i].time < latest_time)
+      backwards++;
+    latest_time = events[i].time;
+    on_key(window, win_data, events[i].key);
+  }
+}
+
+static law_Window display_win;  // Window of the opened display
+static int display_ready = 0;
+static int display_keys = 0;
+static int producer_done = 0;   // The display is closed once the producer is done
+
+static void on_display_key(law_Window window, law_Data* win_data, int key) {
+  display_keys++;
+}
+
+// Thread of the opened display, consuming its own ring
+static void* serve_display(void* arg) {
+  law_Display display = law_openDisplay(":1");
+  law_Window window = law_create(100, 100, L"Opened display", NULL);
+  if (display == NULL || window == NULL) {
+    __LAW_STORE_RELEASE(&display_ready, -1);
+    return NULL;
+  }
+  law_getData(window)->event.key.down = on_display_key;
+  display_win = window;
+  __LAW_STORE_RELEASE(&display_ready, 1);
+
+  unsigned long long deadline = __law_now() + 10000000; // 10 s
+  while ((display_keys < DISPLAY_EVENTS || !__LAW_LOAD_ACQUIRE(&producer_done)) && __law_now() < deadline) {
+    law_update(NULL);
+    sched_yield();
+  }
+  law_destroy(window);
+  law_closeDisplay(display);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  win = law_create(400, 100, L"Input ring", NULL);
+  if (!win) return 1;
+  law_setBatchHandler(win, on_batch);
+
+  unsigned long long start = __law_now();
+  pthread_t thread;
+  pthread_create(&thread, NULL, producer, NULL);
+  while (expected < EVENTS && !out_of_order) {
+    law_update(NULL);
+    sched_yield();
+  }
+  pthread_join(thread, NULL);
+  unsigned long long elapsed = __law_now() - start;
+
+  law_destroy(win);
+
+  printf("%d events, %.1f ns/event\n", expected, elapsed * 1000.0 / EVENTS);
+  if (out_of_order || backwards || expected != EVENTS) {
+    printf("FAILED: %d out of order, %d timestamps going back\n", out_of_order, backwards);
+    return 1;
+  }
+
+  // Destroyed windows are rejected
+  law_Event key = { LAW_EVENT_KEY_DOWN };
+  if (law_postEventFromThread(win, &key)) {
+    printf("FAILED: event of a destroyed window pushed\n");
+    return 1;
+  }
+
+  // The events of a window of another display go to the ring of that display
+  pthread_create(&thread, NULL, serve_display, NULL);
+  while (!__LAW_LOAD_ACQUIRE(&display_ready))
+    sched_yield();
+  for (int i = 0; display_ready > 0 && i < DISPLAY_EVENTS; i++)
+    while (!law_postEventFromThread(display_win, &key))
+      sched_yield();
+  __LAW_STORE_RELEASE(&producer_done, 1);
+  law_update(NULL); // The default display has nothing to deliver
+  pthread_join(thread, NULL);
+
+  printf("%d events on the opened display\n", display_keys);
+  if (display_keys != DISPLAY_EVENTS) {
+    printf("FAILED: events of the opened display\n");
+    return 1;
+  }
+  printf("All input ring checks passed\n");
+  return 0;
+}
@@ -0,0 +1,170 @@
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Checks the key translation tables against the native key codes listed below
+
+typedef struct {
+  unsigned long code; // Native key code
+  int key;            // LAW_KEY_*
+} KeyCode;
+
+// Windows virtual-key codes (VK_*)
+static const KeyCode vk_codes[] = {
+  { 0x08, LAW_KEY_BACKSPACE }, { 0x09, LAW_KEY_TAB }, { 0x0D, LAW_KEY_ENTER }, { 0x10, LAW_KEY_LEFT_SHIFT },
+  { 0x11, LAW_KEY_LEFT_CONTROL }, { 0x12, LAW_KEY_LEFT_ALT }, { 0x13, LAW_KEY_PAUSE }, { 0x14, LAW_KEY_CAPS_LOCK },
+  { 0x1B, LAW_KEY_ESCAPE }, { 0x20, LAW_KEY_SPACE }, { 0x21, LAW_KEY_PAGE_UP }, { 0x22, LAW_KEY_PAGE_DOWN },
+  { 0x23, LAW_KEY_END }, { 0x24, LAW_KEY_HOME }, { 0x25, LAW_KEY_LEFT }, { 0x26, LAW_KEY_UP },
+  { 0x27, LAW_KEY_RIGHT }, { 0x28, LAW_KEY_DOWN }, { 0x2C, LAW_KEY_PRINT_SCREEN }, { 0x2D, LAW_KEY_INSERT },
+  { 0x2E, LAW_KEY_DELETE }, { 0x30, LAW_KEY_0 }, { 0x31, LAW_KEY_1 }, { 0x32, LAW_KEY_2 },
+  { 0x33, LAW_KEY_3 }, { 0x34, LAW_KEY_4 }, { 0x35, LAW_KEY_5 }, { 0x36, LAW_KEY_6 },
+  { 0x37, LAW_KEY_7 }, { 0x38, LAW_KEY_8 }, { 0x39, LAW_KEY_9 }, { 0x41, LAW_KEY_A },
+  { 0x42, LAW_KEY_B }, { 0x43, LAW_KEY_C }, { 0x44, LAW_KEY_D }, { 0x45, LAW_KEY_E },
+  { 0x46, LAW_KEY_F }, { 0x47, LAW_KEY_G }, { 0x48, LAW_KEY_H }, { 0x49, LAW_KEY_I },
+  { 0x4A, LAW_KEY_J }, { 0x4B, LAW_KEY_K }, { 0x4C, LAW_KEY_L }, { 0x4D, LAW_KEY_M },
+  { 0x4E, LAW_KEY_N }, { 0x4F, LAW_KEY_O }, { 0x50, LAW_KEY_P }, { 0x51, LAW_KEY_Q },
+  { 0x52, LAW_KEY_R }, { 0x53, LAW_KEY_S }, { 0x54, LAW_KEY_T }, { 0x55, LAW_KEY_U },
+  { 0x56, LAW_KEY_V }, { 0x57, LAW_KEY_W }, { 0x58, LAW_KEY_X }, { 0x59, LAW_KEY_Y },
+  { 0x5A, LAW_KEY_Z }, { 0x5B, LAW_KEY_LEFT_SUPER }, { 0x5C, LAW_KEY_RIGHT_SUPER }, { 0x5D, LAW_KEY_MENU },
+  { 0x60, LAW_KEY_KP_0 }, { 0x61, LAW_KEY_KP_1 }, { 0x62, LAW_KEY_KP_2 }, { 0x63, LAW_KEY_KP_3 },
+  { 0x64, LAW_KEY_KP_4 }, { 0x65, LAW_KEY_KP_5 }, { 0x66, LAW_KEY_KP_6 }, { 0x67, LAW_KEY_KP_7 },
+  { 0x68, LAW_KEY_KP_8 }, { 0x69, LAW_KEY_KP_9 }, { 0x6A, LAW_KEY_KP_MULTIPLY }, { 0x6B, LAW_KEY_KP_ADD },
+  { 0x6D, LAW_KEY_KP_SUBTRACT }, { 0x6E, LAW_KEY_KP_DECIMAL }, { 0x6F, LAW_KEY_KP_DIVIDE }, { 0x70, LAW_KEY_F1 },
+  { 0x71, LAW_KEY_F2 }, { 0x72, LAW_KEY_F3 }, { 0x73, LAW_KEY_F4 }, { 0x74, LAW_KEY_F5 },
+  { 0x75, LAW_KEY_F6 }, { 0x76, LAW_KEY_F7 }, { 0x77, LAW_KEY_F8 }, { 0x78, LAW_KEY_F9 },
+  { 0x79, LAW_KEY_F10 }, { 0x7A, LAW_KEY_F11 }, { 0x7B, LAW_KEY_F12 }, { 0x90, LAW_KEY_NUM_LOCK },
+  { 0x91, LAW_KEY_SCROLL_LOCK }, { 0xA0, LAW_KEY_LEFT_SHIFT }, { 0xA1, LAW_KEY_RIGHT_SHIFT }, { 0xA2, LAW_KEY_LEFT_CONTROL },
+  { 0xA3, LAW_KEY_RIGHT_CONTROL }, { 0xA4, LAW_KEY_LEFT_ALT }, { 0xA5, LAW_KEY_RIGHT_ALT }, { 0xBA, LAW_KEY_SEMICOLON },
+  { 0xBB, LAW_KEY_EQUAL }, { 0xBC, LAW_KEY_COMMA }, { 0xBD, LAW_KEY_MINUS }, { 0xBE, LAW_KEY_PERIOD },
+  { 0xBF, LAW_KEY_SLASH }, { 0xC0, LAW_KEY_GRAVE }, { 0xDB, LAW_KEY_LEFT_BRACKET }, { 0xDC, LAW_KEY_BACKSLASH },
+  { 0xDD, LAW_KEY_RIGHT_BRACKET }, { 0xDE, LAW_KEY_APOSTROPHE },
+};
+
+// Windows virtual-key codes of extended keys
+static const KeyCode vk_extended_codes[] = {
+  { 0x0D, LAW_KEY_KP_ENTER }, { 0x10, LAW_KEY_RIGHT_SHIFT }, { 0x11, LAW_KEY_RIGHT_CONTROL }, { 0x12, LAW_KEY_RIGHT_ALT },
+};
+
+// X11 keysyms (XK_*)
+static const KeyCode keysym_codes[] = {
+  { 0x0020, LAW_KEY_SPACE }, { 0x0027, LAW_KEY_APOSTROPHE }, { 0x002C, LAW_KEY_COMMA }, { 0x002D, LAW_KEY_MINUS },
+  { 0x002E, LAW_KEY_PERIOD }, { 0x002F, LAW_KEY_SLASH }, { 0x0030, LAW_KEY_0 }, { 0x0031, LAW_KEY_1 },
+  { 0x0032, LAW_KEY_2 }, { 0x0033, LAW_KEY_3 }, { 0x0034, LAW_KEY_4 }, { 0x0035, LAW_KEY_5 },
+  { 0x0036, LAW_KEY_6 }, { 0x0037, LAW_KEY_7 }, { 0x0038, LAW_KEY_8 }, { 0x0039, LAW_KEY_9 },
+  { 0x003B, LAW_KEY_SEMICOLON }, { 0x003D, LAW_KEY_EQUAL }, { 0x0041, LAW_KEY_A }, { 0x0042, LAW_KEY_B },
+  { 0x0043, LAW_KEY_C }, { 0x0044, LAW_KEY_D }, { 0x0045, LAW_KEY_E }, { 0x0046, LAW_KEY_F },
+  { 0x0047, LAW_KEY_G }, { 0x0048, LAW_KEY_H }, { 0x0049, LAW_KEY_I }, { 0x004A, LAW_KEY_J },
+  { 0x004B, LAW_KEY_K }, { 0x004C, LAW_KEY_L }, { 0x004D, LAW_KEY_M }, { 0x004E, LAW_KEY_N },
+  { 0x004F, LAW_KEY_O }, { 0x0050, LAW_KEY_P }, { 0x0051, LAW_KEY_Q }, { 0x0052, LAW_KEY_R },
+  { 0x0053, LAW_KEY_S }, { 0x0054, LAW_KEY_T }, { 0x0055, LAW_KEY_U }, { 0x0056, LAW_KEY_V },
+  { 0x0057, LAW_KEY_W }, { 0x0058, LAW_KEY_X }, { 0x0059, LAW_KEY_Y }, { 0x005A, LAW_KEY_Z },
+  { 0x005B, LAW_KEY_LEFT_BRACKET }, { 0x005C, LAW_KEY_BACKSLASH }, { 0x005D, LAW_KEY_RIGHT_BRACKET }, { 0x0060, LAW_KEY_GRAVE },
+  { 0x0061, LAW_KEY_A }, { 0x0062, LAW_KEY_B }, { 0x0063, LAW_KEY_C }, { 0x0064, LAW_KEY_D },
+  { 0x0065, LAW_KEY_E }, { 0x0066, LAW_KEY_F }, { 0x0067, LAW_KEY_G }, { 0x0068, LAW_KEY_H },
+  { 0x0069, LAW_KEY_I }, { 0x006A, LAW_KEY_J }, { 0x006B, LAW_KEY_K }, { 0x006C, LAW_KEY_L },
+  { 0x006D, LAW_KEY_M }, { 0x006E, LAW_KEY_N }, { 0x006F, LAW_KEY_O }, { 0x0070, LAW_KEY_P },
+  { 0x0071, LAW_KEY_Q }, { 0x0072, LAW_KEY_R }, { 0x0073, LAW_KEY_S }, { 0x0074, LAW_KEY_T },
+  { 0x0075, LAW_KEY_U }, { 0x0076, LAW_KEY_V }, { 0x0077, LAW_KEY_W }, { 0x0078, LAW_KEY_X },
+  { 0x0079, LAW_KEY_Y }, { 0x007A, LAW_KEY_Z }, { 0xFF08, LAW_KEY_BACKSPACE }, { 0xFF09, LAW_KEY_TAB },
+  { 0xFF0D, LAW_KEY_ENTER }, { 0xFF13, LAW_KEY_PAUSE }, { 0xFF14, LAW_KEY_SCROLL_LOCK }, { 0xFF1B, LAW_KEY_ESCAPE },
+  { 0xFF50, LAW_KEY_HOME }, { 0xFF51, LAW_KEY_LEFT }, { 0xFF52, LAW_KEY_UP }, { 0xFF53, LAW_KEY_RIGHT },
+  { 0xFF54, LAW_KEY_DOWN }, { 0xFF55, LAW_KEY_PAGE_UP }, { 0xFF56, LAW_KEY_PAGE_DOWN }, { 0xFF57, LAW_KEY_END },
+  { 0xFF61, LAW_KEY_PRINT_SCREEN }, { 0xFF63, LAW_KEY_INSERT }, { 0xFF67, LAW_KEY_MENU }, { 0xFF7F, LAW_KEY_NUM_LOCK },
+  { 0xFF8D, LAW_KEY_KP_ENTER }, { 0xFF95, LAW_KEY_KP_7 }, { 0xFF96, LAW_KEY_KP_4 }, { 0xFF97, LAW_KEY_KP_8 },
+  { 0xFF98, LAW_KEY_KP_6 }, { 0xFF99, LAW_KEY_KP_2 }, { 0xFF9A, LAW_KEY_KP_9 }, { 0xFF9B, LAW_KEY_KP_3 },
+  { 0xFF9C, LAW_KEY_KP_1 }, { 0xFF9D, LAW_KEY_KP_5 }, { 0xFF9E, LAW_KEY_KP_0 }, { 0xFF9F, LAW_KEY_KP_DECIMAL },
+  { 0xFFAA, LAW_KEY_KP_MULTIPLY }, { 0xFFAB, LAW_KEY_KP_ADD }, { 0xFFAD, LAW_KEY_KP_SUBTRACT }, { 0xFFAE, LAW_KEY_KP_DECIMAL },
+  { 0xFFAF, LAW_KEY_KP_DIVIDE }, { 0xFFB0, LAW_KEY_KP_0 }, { 0xFFB1, LAW_KEY_KP_1 }, { 0xFFB2, LAW_KEY_KP_2 },
+  { 0xFFB3, LAW_KEY_KP_3 }, { 0xFFB4, LAW_KEY_KP_4 }, { 0xFFB5, LAW_KEY_KP_5 }, { 0xFFB6, LAW_KEY_KP_6 },
+  { 0xFFB7, LAW_KEY_KP_7 }, { 0xFFB8, LAW_KEY_KP_8 }, { 0xFFB9, LAW_KEY_KP_9 }, { 0xFFBD, LAW_KEY_KP_EQUAL },
+  { 0xFFBE, LAW_KEY_F1 }, { 0xFFBF, LAW_KEY_F2 }, { 0xFFC0, LAW_KEY_F3 }, { 0xFFC1, LAW_KEY_F4 },
+  { 0xFFC2, LAW_KEY_F5 }, { 0xFFC3, LAW_KEY_F6 }, { 0xFFC4, LAW_KEY_F7 }, { 0xFFC5, LAW_KEY_F8 },
+  { 0xFFC6, LAW_KEY_F9 }, { 0xFFC7, LAW_KEY_F10 }, { 0xFFC8, LAW_KEY_F11 }, { 0xFFC9, LAW_KEY_F12 },
+  { 0xFFE1, LAW_KEY_LEFT_SHIFT }, { 0xFFE2, LAW_KEY_RIGHT_SHIFT }, { 0xFFE3, LAW_KEY_LEFT_CONTROL }, { 0xFFE4, LAW_KEY_RIGHT_CONTROL },
+  { 0xFFE5, LAW_KEY_CAPS_LOCK }, { 0xFFE9, LAW_KEY_LEFT_ALT }, { 0xFFEA, LAW_KEY_RIGHT_ALT }, { 0xFFEB, LAW_KEY_LEFT_SUPER },
+  { 0xFFEC, LAW_KEY_RIGHT_SUPER }, { 0xFFFF, LAW_KEY_DELETE },
+};
+
+// Linux evdev key codes (KEY_*)
+static const KeyCode evdev_codes[] = {
+  { 1, LAW_KEY_ESCAPE }, { 2, LAW_KEY_1 }, { 3, LAW_KEY_2 }, { 4, LAW_KEY_3 }, { 5, LAW_KEY_4 },
+  { 6, LAW_KEY_5 }, { 7, LAW_KEY_6 }, { 8, LAW_KEY_7 }, { 9, LAW_KEY_8 }, { 10, LAW_KEY_9 },
+  { 11, LAW_KEY_0 }, { 12, LAW_KEY_MINUS }, { 13, LAW_KEY_EQUAL }, { 14, LAW_KEY_BACKSPACE }, { 15, LAW_KEY_TAB },
+  { 16, LAW_KEY_Q }, { 17, LAW_KEY_W }, { 18, LAW_KEY_E }, { 19, LAW_KEY_R }, { 20, LAW_KEY_T },
+  { 21, LAW_KEY_Y }, { 22, LAW_KEY_U }, { 23, LAW_KEY_I }, { 24, LAW_KEY_O }, { 25, LAW_KEY_P },
+  { 26, LAW_KEY_LEFT_BRACKET }, { 27, LAW_KEY_RIGHT_BRACKET }, { 28, LAW_KEY_ENTER }, { 29, LAW_KEY_LEFT_CONTROL }, { 30, LAW_KEY_A },
+  { 31, LAW_KEY_S }, { 32, LAW_KEY_D }, { 33, LAW_KEY_F }, { 34, LAW_KEY_G }, { 35, LAW_KEY_H },
+  { 36, LAW_KEY_J }, { 37, LAW_KEY_K }, { 38, LAW_KEY_L }, { 39, LAW_KEY_SEMICOLON }, { 40, LAW_KEY_APOSTROPHE },
+  { 41, LAW_KEY_GRAVE }, { 42, LAW_KEY_LEFT_SHIFT }, { 43, LAW_KEY_BACKSLASH }, { 44, LAW_KEY_Z }, { 45, LAW_KEY_X },
+  { 46, LAW_KEY_C }, { 47, LAW_KEY_V }, { 48, LAW_KEY_B }, { 49, LAW_KEY_N }, { 50, LAW_KEY_M },
+  { 51, LAW_KEY_COMMA }, { 52, LAW_KEY_PERIOD }, { 53, LAW_KEY_SLASH }, { 54, LAW_KEY_RIGHT_SHIFT }, { 55, LAW_KEY_KP_MULTIPLY },
+  { 56, LAW_KEY_LEFT_ALT }, { 57, LAW_KEY_SPACE }, { 58, LAW_KEY_CAPS_LOCK }, { 59, LAW_KEY_F1 }, { 60, LAW_KEY_F2 },
+  { 61, LAW_KEY_F3 }, { 62, LAW_KEY_F4 }, { 63, LAW_KEY_F5 }, { 64, LAW_KEY_F6 }, { 65, LAW_KEY_F7 },
+  { 66, LAW_KEY_F8 }, { 67, LAW_KEY_F9 }, { 68, LAW_KEY_F10 }, { 69, LAW_KEY_NUM_LOCK }, { 70, LAW_KEY_SCROLL_LOCK },
+  { 71, LAW_KEY_KP_7 }, { 72, LAW_KEY_KP_8 }, { 73, LAW_KEY_KP_9 }, { 74, LAW_KEY_KP_SUBTRACT }, { 75, LAW_KEY_KP_4 },
+  { 76, LAW_KEY_KP_5 }, { 77, LAW_KEY_KP_6 }, { 78, LAW_KEY_KP_ADD }, { 79, LAW_KEY_KP_1 }, { 80, LAW_KEY_KP_2 },
+  { 81, LAW_KEY_KP_3 }, { 82, LAW_KEY_KP_0 }, { 83, LAW_KEY_KP_DECIMAL }, { 87, LAW_KEY_F11 }, { 88, LAW_KEY_F12 },
+  { 96, LAW_KEY_KP_ENTER }, { 97, LAW_KEY_RIGHT_CONTROL }, { 98, LAW_KEY_KP_DIVIDE }, { 99, LAW_KEY_PRINT_SCREEN }, { 100, LAW_KEY_RIGHT_ALT },
+  { 102, LAW_KEY_HOME }, { 103, LAW_KEY_UP }, { 104, LAW_KEY_PAGE_UP }, { 105, LAW_KEY_LEFT }, { 106, LAW_KEY_RIGHT },
+  { 107, LAW_KEY_END }, { 108, LAW_KEY_DOWN }, { 109, LAW_KEY_PAGE_DOWN }, { 110, LAW_KEY_INSERT }, { 111, LAW_KEY_DELETE },
+  { 117, LAW_KEY_KP_EQUAL }, { 119, LAW_KEY_PAUSE }, { 125, LAW_KEY_LEFT_SUPER }, { 126, LAW_KEY_RIGHT_SUPER }, { 127, LAW_KEY_MENU },
+};
+
+#define COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+static int failures = 0;
+
+static void check(const char* table, unsigned long code, int key, int expected) {
+  if (key != expected) {
+    printf("%s: 0x%lX translates to %d, expected %d\n", table, code, key, expected);
+    failures++;
+  }
+}
+
+// Expected key of a native code, or LAW_KEY_UNKNOWN if not listed
+static int expect(const KeyCode* codes, size_t count, unsigned long code) {
+  for (size_t i = 0; i < count; i++)
+    if (codes[i].code == code)
+      return codes[i].key;
+  return LAW_KEY_UNKNOWN;
+}
+
+int main(int argc, char *argv[]) {
+  // Every entry of every table
+  for (unsigned int vk = 0; vk < 0x100; vk++) {
+    int key = expect(vk_codes, COUNT(vk_codes), vk);
+    check("vk", vk, law_keyFromVk(vk, 0), key);
+
+    int extended = expect(vk_extended_codes, COUNT(vk_extended_codes), vk);
+    check("vk (extended)", vk, law_keyFromVk(vk, 1), extended ? extended : key);
+  }
+
+  for (unsigned long keysym = 0; keysym < 0x100; keysym++)
+    check("keysym", keysym, law_keyFromKeysym(keysym), expect(keysym_codes, COUNT(keysym_codes), keysym));
+  for (unsigned long keysym = 0xFF00; keysym < 0x10000; keysym++)
+    check("keysym", keysym, law_keyFromKeysym(keysym), expect(keysym_codes, COUNT(keysym_codes), keysym));
+
+  for (unsigned int code = 0; code < 0x100; code++)
+    check("evdev", code, law_keyFromEvdev(code), expect(evdev_codes, COUNT(evdev_codes), code));
+
+  // Codes outside of the tables
+  check("vk", 0x141, law_keyFromVk(0x141, 0), LAW_KEY_UNKNOWN);
+  check("keysym", 0x141, law_keyFromKeysym(0x141), LAW_KEY_UNKNOWN);         // outside of Latin-1
+  check("keysym", 0xFE03, law_keyFromKeysym(0xFE03), LAW_KEY_UNKNOWN);       // ISO_Level3_Shift
+  check("keysym", 0x1000041, law_keyFromKeysym(0x1000041), LAW_KEY_UNKNOWN); // Unicode keysym
+  check("keysym", 0x1FF0D, law_keyFromKeysym(0x1FF0D), LAW_KEY_UNKNOWN);
+  check("evdev", 0x100, law_keyFromEvdev(0x100), LAW_KEY_UNKNOWN);
+
+  // The same key is the same constant on every platform
+  check("vk", 0x41, law_keyFromVk(0x41, 0), law_keyFromKeysym(0x61));
+  check("evdev", 30, law_keyFromEvdev(30), law_keyFromKeysym(0x41));
+  check("evdev", 96, law_keyFromEvdev(96), law_keyFromVk(0x0D, 1));
+
+  if (failures) {
+    printf("%d key translation(s) failed\n", failures);
+    return 1;
+  }
+  printf("All key translations passed\n");
+  return 0;
+}
@@ -0,0 +1,55 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+#include <time.h>
+
+// Checks the tick rate and the CPU use of `law_runLoop`
+
+#define TICK_HZ 500
+#define TICKS 1000 // 2 seconds
+
+static law_Window win;
+static int ticks = 0;
+static int frames = 0;
+static int bad_alpha = 0;
+
+static void update(double dt) {
+  if (++ticks == TICKS)
+    law_exit(7);
+}
+
+static void render(double alpha) {
+  if (alpha < 0.0 || alpha >= 1.0)
+    bad_alpha++;
+  frames++;
+}
+
+int main(int argc, char *argv[]) {
+  win = law_create(400, 100, L"Loop", NULL);
+  if (!win) return 1;
+
+  unsigned long long start = __law_now();
+  clock_t cpu_start = clock();
+  int exit_code = law_runLoop(update, render, TICK_HZ);
+  double cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+  double elapsed = (double)(__law_now() - start) / 1e6;
+
+  double rate = ticks / elapsed;
+  printf("%d ticks in %.3f s (%.1f Hz), %d frames, %.1f%% CPU\n", ticks, elapsed, rate, frames, cpu * 100.0 / elapsed);
+
+  law_destroy(win);
+  if (exit_code != 7 || bad_alpha || rate < TICK_HZ * 0.98 || rate > TICK_HZ * 1.02) {
+    printf("FAILED: exit code %d, %d frames with a bad alpha\n", exit_code, bad_alpha);
+    return 1;
+  }
+
+  // Without windows the loop ends by itself
+  if (law_runLoop(update, NULL, TICK_HZ) != 0) {
+    printf("FAILED: loop without windows\n");
+    return 1;
+  }
+  printf("All loop checks passed\n");
+  return 0;
+}
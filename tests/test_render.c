@@ -0,0 +1,83 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <sched.h>
+#include <stdio.h>
+
+// Checks the render threads (`law_startRenderThread`): frames follow the
+// size of the window, and resizing or destroying a rendering window is safe
+
+#define WINDOWS 4
+#define UPDATES 3000
+
+typedef struct {
+  int frames;
+  int width, height;   // Size of the latest frame
+  int bad_size;        // Frames larger than the window ever was
+} Renderer;
+
+static Renderer renderers[WINDOWS];
+
+static void render(law_Window window, law_Frame* frame, void* user) {
+  Renderer* renderer = (Renderer*)user;
+  if (frame->width > 640 || frame->height > 480)
+    renderer->bad_size++;
+  for (int y = 0; y < frame->height; y++)
+    for (int x = 0; x < frame->width; x++)
+      frame->pixels[y * frame->stride + x] = (unsigned int)(renderer->frames + x + y);
+  renderer->width = frame->width;
+  renderer->height = frame->height;
+  renderer->frames++;
+}
+
+int main(int argc, char *argv[]) {
+  law_Window windows[WINDOWS];
+  for (int i = 0; i < WINDOWS; i++) {
+    windows[i] = law_create(320, 240, L"Render", NULL);
+    if (!windows[i] || !law_startRenderThread(windows[i], render, &renderers[i])) return 1;
+  }
+  if (law_startRenderThread(windows[0], render, &renderers[0])) {
+    printf("FAILED: second render thread started\n");
+    return 1;
+  }
+
+  int failed = 0;
+  for (int update = 0; update < UPDATES; update++) {
+    if (update == UPDATES / 3)
+      for (int i = 0; i < WINDOWS; i++)
+        law_setSize(windows[i], 640, 480);
+    if (update == UPDATES / 2)
+      law_destroy(windows[WINDOWS - 1]); // While its thread renders
+    if (update == 2 * UPDATES / 3)
+      law_stopRenderThread(windows[0]);
+    law_update(NULL);
+    sched_yield(); // Let the render threads run on a single core too
+  }
+
+  // The renderers are read once their threads are stopped
+  for (int i = 1; i < WINDOWS - 1; i++)
+    law_stopRenderThread(windows[i]);
+
+  for (int i = 0; i < WINDOWS - 1; i++) {
+    Renderer* renderer = &renderers[i];
+    if (renderer->frames < 2 || renderer->bad_size || renderer->width != 640 || renderer->height != 480) {
+      printf("FAILED: window %d, %d frames, latest %dx%d\n", i, renderer->frames, renderer->width, renderer->height);
+      failed = 1;
+    }
+  }
+  int frames = renderers[0].frames;
+  law_update(NULL);
+  if (renderers[0].frames != frames) {
+    printf("FAILED: window 0 still rendering after law_stopRenderThread\n");
+    failed = 1;
+  }
+
+  for (int i = 0; i < WINDOWS - 1; i++)
+    law_destroy(windows[i]);
+
+  if (failed)
+    return 1;
+  printf("All render thread checks passed (%d, %d, %d frames)\n", renderers[0].frames, renderers[1].frames, renderers[2].frames);
+  return 0;
+}
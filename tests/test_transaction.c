@@ -0,0 +1,80 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+#include <wchar.h>
+
+// Checks `law_beginUpdate` / `law_commitUpdate`: the property changes are
+// recorded, then applied at the outermost commit with one event per property
+
+static int moves = 0, resizes = 0;
+static int last_x, last_y, last_width, last_height;
+
+static void on_move(law_Window window, law_Data* win_data, int x, int y) {
+  moves++;
+  last_x = x;
+  last_y = y;
+}
+
+static void on_resize(law_Window window, law_Data* win_data, int width, int height) {
+  resizes++;
+  last_width = width;
+  last_height = height;
+}
+
+int main(int argc, char *argv[]) {
+  law_Window window = law_create(400, 100, L"Before", NULL);
+  if (!window) return 1;
+  law_getData(window)->event.window.move = on_move;
+  law_getData(window)->event.window.resize = on_resize;
+  int failed = 0;
+
+  law_beginUpdate(window);
+  law_setPos(window, 10, 20);
+  law_setSize(window, 640, 480);
+  law_beginUpdate(window); // Nested
+  law_setPos(window, 30, 40);
+  law_setTitle(window, L"After");
+  law_commitUpdate(window);
+
+  // Nothing applied before the outermost commit
+  int width, height, x, y;
+  law_getSize(window, &width, &height);
+  law_getPos(window, &x, &y);
+  law_update(NULL);
+  if (width != 400 || height != 100 || x != 0 || y != 0 || moves || resizes || wcscmp(law_getTitle(window), L"Before")) {
+    printf("FAILED: changes applied before the commit\n");
+    failed = 1;
+  }
+
+  law_commitUpdate(window);
+  law_update(NULL);
+  law_getSize(window, &width, &height);
+  law_getPos(window, &x, &y);
+  printf("%d move(s) to %d,%d, %d resize(s) to %dx%d\n", moves, last_x, last_y, resizes, last_width, last_height);
+  if (width != 640 || height != 480 || x != 30 || y != 40 || moves != 1 || resizes != 1
+      || last_x != 30 || last_y != 40 || wcscmp(law_getTitle(window), L"After")) {
+    printf("FAILED: changes of the commit\n");
+    failed = 1;
+  }
+
+  // Outside of a transaction, applied at once; an extra commit does nothing
+  law_commitUpdate(window);
+  law_setSize(window, 320, 240);
+  law_getSize(window, &width, &height);
+  if (width != 320 || height != 240) {
+    printf("FAILED: change outside of a transaction\n");
+    failed = 1;
+  }
+
+  // Destroyed during a transaction, the recorded title is freed
+  law_beginUpdate(window);
+  law_setTitle(window, L"Never applied");
+  law_destroy(window);
+
+  if (failed)
+    return 1;
+  printf("All transaction checks passed\n");
+  return 0;
+}
@@ -33,9 +33,8 @@ int main(int argc, char *argv[]) {
   windata->event.window.maximize = on_maximize;
 
 
-  while (windata->running) {
-    law_update(NULL);
-  }
+  // Events at 60 Hz, sleeping in between
+  law_runLoop(NULL, NULL, 60);
 
   law_destroy(win);
   
@@ -0,0 +1,103 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.h"
+
+#include <stdio.h>
+
+// Checks the window pool (`law_acquirePooledWindow` / `law_releasePooledWindow`):
+// released windows are reused by kind, hidden and reset, and not counted as open
+
+enum { KIND_TOOLTIP = 1, KIND_POPUP };
+
+static int keys = 0, destroys = 0;
+
+static void on_key(law_Window window, law_Data* win_data, int key) {
+  keys++;
+}
+
+static void on_close(law_Window window, law_Data* win_data) {
+  law_releasePooledWindow(window); // From its own handler
+}
+
+static void on_destroy(law_Window window, law_Data* win_data) {
+  destroys++;
+}
+
+int main(int argc, char *argv[]) {
+  __law_Display* display = __law_currentDisplay();
+  int failed = 0;
+
+  law_Window tooltip = law_acquirePooledWindow(KIND_TOOLTIP, 200, 40);
+  if (!tooltip) return 1;
+  law_Data* data = law_getData(tooltip);
+  data->event.key.down = on_key;
+  data->user_data = &keys;
+  law_show(tooltip);
+  law_setTitle(tooltip, L"Saved");
+  law_setPos(tooltip, 120, 80);
+
+  // Released with a queued event, which is dropped
+  law_Event key = { LAW_EVENT_KEY_DOWN };
+  law_postEvent(tooltip, &key);
+  law_releasePooledWindow(tooltip);
+  if (display->windows != 0 || display->pooled != 1) {
+    printf("FAILED: pooled window counted as open\n");
+    failed = 1;
+  }
+
+  // Another kind is created, the same kind is reused
+  law_Window popup = law_acquirePooledWindow(KIND_POPUP, 300, 200);
+  law_Window again = law_acquirePooledWindow(KIND_TOOLTIP, 250, 50);
+  int width, height, x, y;
+  law_getSize(again, &width, &height);
+  law_getPos(again, &x, &y);
+  const wchar_t* title = law_getTitle(again);
+  law_update(NULL);
+  if (popup == tooltip || again != tooltip || width != 250 || height != 50) {
+    printf("FAILED: reuse by kind\n");
+    failed = 1;
+  }
+  if (keys || data->user_data || data->event.key.down || ((__law_HeadlessWindow*)__law_lookup(again))->visible
+      || (title && title[0]) || x != 0 || y != 0) {
+    printf("FAILED: reused window not reset\n");
+    failed = 1;
+  }
+
+  // Released by its close handler during the update
+  law_getData(popup)->event.window.close = on_close;
+  law_Event close = { LAW_EVENT_CLOSE };
+  law_postEvent(popup, &close);
+  law_postEvent(popup, &key);
+  law_update(NULL);
+  if (display->pooled != 1 || law_acquirePooledWindow(KIND_POPUP, 10, 10) != popup) {
+    printf("FAILED: release from a handler\n");
+    failed = 1;
+  }
+
+  // Beyond the size of the pool, the windows are destroyed
+  law_Window windows[LAW_WINDOW_POOL_SIZE + 1];
+  for (int i = 0; i < LAW_WINDOW_POOL_SIZE + 1; i++) {
+    windows[i] = law_acquirePooledWindow(KIND_POPUP, 10, 10);
+    law_getData(windows[i])->event.window.destroy = on_destroy;
+  }
+  for (int i = 0; i < LAW_WINDOW_POOL_SIZE + 1; i++)
+    law_releasePooledWindow(windows[i]);
+  printf("%zu windows pooled, %d destroyed\n", display->pooled, destroys);
+  if (display->pooled != LAW_WINDOW_POOL_SIZE || destroys != 1) {
+    printf("FAILED: size of the pool\n");
+    failed = 1;
+  }
+
+  law_releasePooledWindow(popup);
+  law_releasePooledWindow(again);
+  law_clearWindowPool();
+  if (display->windows != 0 || display->pooled != 0 || display->pool_list) {
+    printf("FAILED: clear the pool\n");
+    failed = 1;
+  }
+
+  if (failed)
+    return 1;
+  printf("All window pool checks passed\n");
+  return 0;
+}
@@ -0,0 +1,81 @@
+#define LAW_HEADLESS
+#define LA_WINDOW_IMPLEMENTATION
+#include "../la_window.hpp"
+
+#include <stdio.h>
+
+// Checks the compile-time binding of the C++ wrapper with the headless backend
+
+struct Counter {
+  int keys = 0;
+  int moves = 0;
+  int last_x = 0;
+  int* destroyed;
+
+  explicit Counter(int* destroyed) : destroyed(destroyed) {}
+
+  void onClose(law::WindowRef window) { window.setRunning(false); }
+  void onKeyDown(law::WindowRef window, int key) { keys += key == LAW_KEY_A; }
+  void onMouseMove(law::WindowRef window, int x, int y) { moves++; last_x = x; }
+  void onDestroy(law::WindowRef window) { (*destroyed)++; }
+  void onMouseDown(int button) {} // Wrong signature, not bound
+};
+
+// Nothing handled, nothing subscribed
+struct Empty {};
+
+static_assert(law::Window<Counter>::event_mask == (LAW_EVENT_MASK(LAW_EVENT_CLOSE) | LAW_EVENT_MASK(LAW_EVENT_KEY_DOWN)
+  | LAW_EVENT_MASK(LAW_EVENT_MOUSE_MOVE) | LAW_EVENT_MASK(LAW_EVENT_DESTROY)), "Wrong event mask");
+static_assert(law::Window<Empty>::event_mask == 0, "Wrong event mask");
+
+static int failed = 0;
+
+static void check(int condition, const char* what) {
+  if (!condition) {
+    printf("FAILED: %s\n", what);
+    failed = 1;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int destroyed = 0;
+  {
+    law::Window<Counter> win(400, 100, L"Wrapper", &destroyed); // Arguments of the handler
+    check((bool)win, "window created");
+
+    law_Event event = { LAW_EVENT_KEY_DOWN };
+    event.key = LAW_KEY_A;
+    check(win.postEvent(event), "key down subscribed");
+
+    event.type = LAW_EVENT_KEY_UP;
+    check(!win.postEvent(event), "key up not subscribed");
+
+    event.type = LAW_EVENT_MOUSE_DOWN;
+    event.button = LAW_MOUSE_LEFT;
+    check(!win.postEvent(event), "mouse down with a wrong signature not subscribed");
+
+    event.type = LAW_EVENT_MOUSE_MOVE;
+    for (int x = 0; x < 10; x++) {
+      event.pos.x = x;
+      win.postEvent(event);
+    }
+
+    event.type = LAW_EVENT_CLOSE;
+    win.postEvent(event);
+
+    law::update();
+    check(win->keys == 1, "key down delivered");
+    check(win->moves == 1 && win->last_x == 9, "mouse moves coalesced");
+    check(!win.running(), "close delivered");
+
+    // The C callbacks keep working for the types the handler does not have
+    law::Window<Empty> other(100, 100);
+    check(!other.postEvent(event), "close not subscribed");
+    check(win.data()->user_data == &win, "user data is the window");
+  }
+  check(destroyed == 1, "destroy delivered by the destructor");
+
+  if (!failed)
+    printf("All wrapper checks passed\n");
+  return failed;
+}